@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace minimal_latency_buffer
+{
+
+/**
+ * Linear clock model of a periodic source, i.e., measurement time stamps are modeled as
+ *
+ *     meas_time_n = phase + n * period + noise
+ *
+ * The phase and the (slowly drifting) period are tracked by a Kalman filter. In contrast to averaging consecutive time
+ * stamp differences, the prediction of the n-th next time stamp is not affected by the accumulated jitter of the
+ * previous time stamps. The number of periods between two samples is derived from the predicted grid, hence, dropped
+ * samples are handled without requiring any external counting.
+ *
+ * All values are handled in nanoseconds relative to the first time stamp to keep the numerical precision.
+ */
+class LinearClockModel
+{
+public:
+  /**
+   * @param drift_stddev Standard deviation of the period random walk per period (relative to the period).
+   * @param alpha        Smoothing factor of the time stamp jitter estimation.
+   */
+  explicit LinearClockModel(double drift_stddev = 1e-5, double alpha = 0.05) : _drift_stddev{ drift_stddev }, _alpha{ alpha }
+  {
+  }
+
+  /**
+   * Initializes the model based on two consecutive time stamps.
+   */
+  void initialize(std::int64_t first_stamp, std::int64_t second_stamp)
+  {
+    _origin = first_stamp;
+    _phase = static_cast<double>(second_stamp - first_stamp);
+    _period = _phase;
+    // uncertain initialization, the filter converges within a few updates
+    const double initial_variance = std::pow(0.1 * _period, 2);
+    _covariance = { initial_variance, 0, 0, initial_variance };
+    // conservative guess of the jitter, otherwise the first (perfectly explained) updates would let the state
+    // uncertainty collapse before the jitter has been estimated
+    _jitter_variance = initial_variance;
+    _initialized = _period > 0;
+  }
+
+  /**
+   * Updates the model with the next time stamp.
+   * @return Number of periods since the previous time stamp (at least one).
+   */
+  std::size_t update(std::int64_t stamp)
+  {
+    const double measurement = static_cast<double>(stamp - _origin);
+    const std::size_t num_periods = periodsUntil(measurement);
+
+    const Covariance prior = predictCovariance(num_periods);
+    const double predicted_phase = _phase + static_cast<double>(num_periods) * _period;
+
+    const double innovation = measurement - predicted_phase;
+    const double innovation_variance = std::max(prior[0] + _jitter_variance, MIN_VARIANCE);
+
+    const double phase_gain = prior[0] / innovation_variance;
+    const double period_gain = prior[2] / innovation_variance;
+
+    _phase = predicted_phase + phase_gain * innovation;
+    _period = _period + period_gain * innovation;
+    _covariance = { (1 - phase_gain) * prior[0],
+                    (1 - phase_gain) * prior[1],
+                    prior[2] - period_gain * prior[0],
+                    prior[3] - period_gain * prior[1] };
+
+    // the time stamp jitter is estimated from the part of the innovation which is not explained by the state
+    // uncertainty
+    const double unexplained_variance = std::max(innovation * innovation - prior[0], 0.0);
+    _jitter_variance = (1 - _alpha) * _jitter_variance + _alpha * unexplained_variance;
+
+    return num_periods;
+  }
+
+  /**
+   * @param stamp       Time stamp of a sample located on the grid (usually the latest one).
+   * @param num_periods Number of periods the requested time stamp is located after the provided one.
+   * @return Predicted time stamp.
+   */
+  [[nodiscard]] std::int64_t predict(std::int64_t stamp, std::size_t num_periods) const
+  {
+    const std::size_t total_periods = periodsUntil(static_cast<double>(stamp - _origin), 0) + num_periods;
+    return _origin + static_cast<std::int64_t>(std::llround(_phase + static_cast<double>(total_periods) * _period));
+  }
+
+  /**
+   * @return Standard deviation of the time stamp predicted by predict() with the same arguments.
+   */
+  [[nodiscard]] double predictionStddev(std::int64_t stamp, std::size_t num_periods) const
+  {
+    const std::size_t total_periods = periodsUntil(static_cast<double>(stamp - _origin), 0) + num_periods;
+    return std::sqrt(predictCovariance(total_periods)[0] + _jitter_variance);
+  }
+
+  [[nodiscard]] double period() const
+  {
+    return _period;
+  }
+
+  [[nodiscard]] double jitterStddev() const
+  {
+    return std::sqrt(_jitter_variance);
+  }
+
+  [[nodiscard]] bool isInitialized() const
+  {
+    return _initialized;
+  }
+
+private:
+  // row-major 2x2 covariance of [phase, period]
+  using Covariance = std::array<double, 4>;
+
+  [[nodiscard]] std::size_t periodsUntil(double measurement, std::size_t min_periods = 1) const
+  {
+    const double periods = std::round((measurement - _phase) / _period);
+    return std::max(min_periods, static_cast<std::size_t>(std::max(periods, 0.0)));
+  }
+
+  /**
+   * Closed form of propagating the covariance k periods into the future considering a period random walk.
+   */
+  [[nodiscard]] Covariance predictCovariance(std::size_t num_periods) const
+  {
+    const auto k = static_cast<double>(num_periods);
+    const double drift_variance = std::pow(_drift_stddev * _period, 2);
+
+    // F_k * P * F_k^T with F_k = [[1, k], [0, 1]]
+    const double phase_variance = _covariance[0] + 2 * k * _covariance[1] + k * k * _covariance[3];
+    const double cross_covariance = _covariance[1] + k * _covariance[3];
+    const double period_variance = _covariance[3];
+
+    // sum_{j=0}^{k-1} F_j * Q * F_j^T with Q = diag(0, drift_variance)
+    const double sum_j = k * (k - 1) / 2;
+    const double sum_j_squared = (k - 1) * k * (2 * k - 1) / 6;
+
+    return { phase_variance + drift_variance * sum_j_squared,
+             cross_covariance + drift_variance * sum_j,
+             cross_covariance + drift_variance * sum_j,
+             period_variance + drift_variance * k };
+  }
+
+  double _drift_stddev;
+  double _alpha;
+  bool _initialized = false;
+
+  std::int64_t _origin = 0;
+  double _phase = 0;
+  double _period = 0;
+  Covariance _covariance{};
+  double _jitter_variance = 0;
+
+  static constexpr double MIN_VARIANCE = 1.0;
+};
+
+}  // namespace minimal_latency_buffer
@@ -23,7 +23,7 @@ public:
   using PopReturn_t = PopReturn<TimeData_t>;
   using MeasTimeComparator_t = MeasTimeComparator<TimeData_t>;
 
-  using MatchingMap_t = MatchingMap<SourceId>;
+  using MatchingState_t = MatchingState<SourceId>;
 
   struct Params
   {
@@ -38,6 +38,7 @@ public:
 
     BatchParams batch;
     MatchParams<SourceId> match;
+    GridParams grid;
   };
 
   explicit FixedLagBuffer(Params params);
@@ -50,17 +51,28 @@ public:
   void reset();
 
   Time getBufferTime() const;
+  Time getWatermark() const;
   Time getCurrentTime() const;
   std::size_t getNumberOfQueuedElements() const;
 
 
 protected:
 
+  /**
+   * Matches the samples of all streams to a single reference sample, the result is stored within _matching_state.
+   * @param ready_for_output_inds Sorted indices of all samples which may be outputted.
+   * @param ref_pos               Position of the reference sample within ready_for_output_inds.
+   * @param begin_idx             First index within _data considered for the matching.
+   */
+  MatchStatus matchReference(const IndexList& ready_for_output_inds, std::size_t ref_pos, std::size_t begin_idx);
+
   Params _params;
   std::vector<TimeData_t> _data;
   Duration _fixed_lag_delay{std::chrono::seconds {0}};
   Time _buffer_time{std::chrono::seconds {0}};
+  Time _watermark{std::chrono::seconds {0}};
   Time _current_time{std::chrono::seconds {0}};
+  MatchingState_t _matching_state;
 
 };
 
@@ -105,6 +117,7 @@ PopReturn<TimeData<SourceId, Data>> FixedLagBuffer<Data, SourceId>::pop(minimal_
 {
   IndexList output_inds;
   IndexList discard_inds;
+  IndexList batch_starts;
 
   // all messages acquired prior to the ref time are can potentially be outputted
   Time ref_meas_time = time - _fixed_lag_delay;
@@ -146,6 +159,28 @@ PopReturn<TimeData<SourceId, Data>> FixedLagBuffer<Data, SourceId>::pop(minimal_
       }
     }
     output_inds = std::move(batch);
+    batch_starts.push_back(0);
+  }
+  else if (_params.mode == BufferMode::GRID and not output_inds.empty())
+  {
+    // all data acquired prior to the ref time has been received, i.e., solely cycles ending prior to it are complete
+    IndexList grid_batches;
+    std::optional<std::int64_t> current_cycle;
+    for (std::size_t idx : output_inds)
+    {
+      const std::int64_t cycle = _params.grid.cycle(_data.at(idx).meas_time);
+      if (_params.grid.cycleEnd(cycle) > ref_meas_time)
+      {
+        break;
+      }
+      if (cycle != current_cycle)
+      {
+        batch_starts.push_back(grid_batches.size());
+        current_cycle = cycle;
+      }
+      grid_batches.push_back(idx);
+    }
+    output_inds = std::move(grid_batches);
   }
   else if(_params.mode == BufferMode::MATCH and not output_inds.empty())
   {
@@ -155,6 +190,7 @@ PopReturn<TimeData<SourceId, Data>> FixedLagBuffer<Data, SourceId>::pop(minimal_
   }
 
   PopReturn_t result{};
+  result.batch_starts = std::move(batch_starts);
   for (std::size_t idx : output_inds)
   {
     result.data.push_back(std::move(_data.at(idx)));
@@ -175,6 +211,16 @@ PopReturn<TimeData<SourceId, Data>> FixedLagBuffer<Data, SourceId>::pop(minimal_
 
   std::sort(_data.begin(), _data.end(), MeasTimeComparator_t());
 
+  // with the configured delay, all samples measured prior to the ref time are received, i.e., the watermark advances
+  // with the pop time even if nothing is released (but never beyond samples held back, e.g., incomplete grid cycles)
+  Time watermark = std::max(_buffer_time, ref_meas_time);
+  if (not _data.empty())
+  {
+    watermark = std::min(watermark, _data.front().meas_time);
+  }
+  _watermark = std::max(_watermark, watermark);
+  result.watermark = _watermark;
+
   return result;
 }
 template <class Data, class SourceId>
@@ -183,69 +229,97 @@ std::pair<typename FixedLagBuffer<Data,SourceId>::IndexList, typename FixedLagBu
   IndexList tuple_inds;
   IndexList delete_inds;
 
-  //////////////////////////////////////////////////
-  // find reference frame (oldest in buffer which may be outputted)
-  //////////////////////////////////////////////////
-  bool found_ref{false};
-  bool found_next_ref{false};
-  std::size_t ref_idx{0};
-  Time oldest_ref_meas_time{ std::chrono::seconds(0) };
-  Time next_ref_meas_time{ std::chrono::seconds(0) };
-  for (auto const& idx : ready_for_output_inds)
+  // every complete tuple is emitted, the scan for the next tuple resumes where the previous one ended
+  // (samples prior to the first ready one are discarded during pop)
+  std::size_t begin_idx{ready_for_output_inds.front()};
+  std::size_t ref_search_idx{begin_idx};
+  while (true)
   {
-    const TimeData_t &element = _data.at(idx);
-    if (element.id == _params.match.reference_stream)
+    //////////////////////////////////////////////////
+    // find reference frame (oldest in buffer which may be outputted)
+    //////////////////////////////////////////////////
+    const auto ref_it = std::find_if(ready_for_output_inds.begin(), ready_for_output_inds.end(),
+                                     [this, ref_search_idx](const std::size_t idx) {
+                                       return idx >= ref_search_idx and _data.at(idx).id == _params.match.reference_stream;
+                                     });
+    if (ref_it == ready_for_output_inds.end())
     {
-      if (not found_ref)
-      {
-        found_ref = true;
-        ref_idx = idx;
-        oldest_ref_meas_time = element.meas_time;
-      }
-      else
-      {
-        found_next_ref = true;
-        next_ref_meas_time = element.meas_time;
-        break;
-      }
+      break;
     }
-  }
-  if (not found_ref)
-  {
-    return {tuple_inds, delete_inds};
-  }
+    const std::size_t ref_idx = *ref_it;
 
-  if (not found_next_ref)
-  {
-    // search received but not yet ready samples for next ref as well
-    for (std::size_t idx{ref_idx+1}; idx < _data.size();++idx)
+    const MatchStatus status = matchReference(ready_for_output_inds, std::distance(ready_for_output_inds.begin(), ref_it), begin_idx);
+    if (status == MatchStatus::WAIT)
     {
-      auto const &element = _data.at(idx);
-      if (element.id == _params.match.reference_stream)
+      break;
+    }
+    if (status == MatchStatus::INCOMPLETE)
+    {
+      // delete current ref since tuple is impossible
+      // other entries will be deleted automatically, as soon as another tuple is successfully created
+      delete_inds.push_back(ref_idx);
+      ref_search_idx = ref_idx + 1;
+      continue;
+    }
+
+    const std::size_t tuple_begin = tuple_inds.size();
+    _matching_state.appendIndices(tuple_inds);
+    std::sort(tuple_inds.begin() + tuple_begin, tuple_inds.end());
+    const Time tuple_meas_time = _data.at(tuple_inds.back()).meas_time;
+
+    // remaining samples up to the latest sample of the tuple can not be outputted anymore
+    // (references prior to the current one have already been deleted)
+    for (; begin_idx < _data.size() and _data.at(begin_idx).meas_time <= tuple_meas_time; ++begin_idx)
+    {
+      const bool deleted_ref = begin_idx < ref_idx and _data.at(begin_idx).id == _params.match.reference_stream;
+      if (not deleted_ref and not std::binary_search(tuple_inds.begin() + tuple_begin, tuple_inds.end(), begin_idx))
       {
-        found_next_ref = true;
-        next_ref_meas_time = element.meas_time;
-        break;
+        delete_inds.push_back(begin_idx);
       }
-
     }
-    if (not found_next_ref)
+    ref_search_idx = begin_idx;
+  }
+
+  return {tuple_inds, delete_inds};
+}
+
+template <class Data, class SourceId>
+MatchStatus FixedLagBuffer<Data, SourceId>::matchReference(const IndexList& ready_for_output_inds,
+                                                           std::size_t ref_pos,
+                                                           std::size_t begin_idx)
+{
+  const std::size_t ref_idx = ready_for_output_inds[ref_pos];
+  const Time oldest_ref_meas_time = _data.at(ref_idx).meas_time;
+
+  bool found_next_ref{false};
+  Time next_ref_meas_time{ std::chrono::seconds(0) };
+  // search received but not yet ready samples for next ref as well
+  for (std::size_t idx{ref_idx+1}; idx < _data.size();++idx)
+  {
+    auto const &element = _data.at(idx);
+    if (element.id == _params.match.reference_stream)
     {
-      // without stream characteristics there is no way of estimating the next ref sample if not already received
-      next_ref_meas_time = Time{std::chrono::seconds {0}};
+      found_next_ref = true;
+      next_ref_meas_time = element.meas_time;
+      break;
     }
   }
+  if (not found_next_ref)
+  {
+    // without stream characteristics there is no way of estimating the next ref sample if not already received
+    next_ref_meas_time = Time{std::chrono::seconds {0}};
+  }
 
   //////////////////////////////////////////////////
   // check for fitting matches
   //////////////////////////////////////////////////
-  MatchingMap_t matching_map;
-  MatchMapEntry &ref_el = matching_map[_params.match.reference_stream];
+  _matching_state.clear();
+  MatchMapEntry &ref_el = _matching_state[_params.match.reference_stream];
   ref_el.idx = ref_idx;
   ref_el.tau = 0;
   // flags if data was found for a stream fitting better to the next sample AND no other sample for the current ref
   bool found_better_for_next{false};
-  for (std::size_t idx{0}; idx < _data.size(); ++idx)
+  for (std::size_t idx{begin_idx}; idx < _data.size(); ++idx)
   {
     const TimeData_t &element = _data.at(idx);
 
@@ -260,9 +334,8 @@ std::pair<typename FixedLagBuffer<Data,SourceId>::IndexList, typename FixedLagBu
 
     if (next_diff < current_diff)
     {
-      auto map_it=matching_map.find(element.id);
       // no other sample with this id was found before
-      if (map_it == matching_map.end())
+      if (not _matching_state.contains(element.id))
       {
         found_better_for_next = true;
       }
@@ -271,7 +344,7 @@ std::pair<typename FixedLagBuffer<Data,SourceId>::IndexList, typename FixedLagBu
     }
 
     // compare entry is created at first access
-    MatchMapEntry &compare = matching_map[element.id];
+    MatchMapEntry &compare = _matching_state[element.id];
     double current_diff_double = std::chrono::duration<double>(current_diff).count();
     if (current_diff_double < compare.tau)
     {
@@ -281,22 +354,11 @@ std::pair<typename FixedLagBuffer<Data,SourceId>::IndexList, typename FixedLagBu
   }
 
   // IMPORTANT: check if tuple possible before waiting if 'found_better_sample'
-  if (matching_map.size() != _params.match.num_streams)
+  if (_matching_state.size() != _params.match.num_streams)
   {
-    if (found_better_for_next)
-    {
-      // delete current ref since tuple is impossible
-      // other entries will be deleted automatically, as soon as another tuple is successfully created
-      delete_inds.push_back(ref_idx);
-    }
-
-    return {tuple_inds, delete_inds};
+    return found_better_for_next ? MatchStatus::INCOMPLETE : MatchStatus::WAIT;
   }
-
-  tuple_inds.reserve(matching_map.size());
-  std::transform(matching_map.begin(), matching_map.end(), std::back_inserter(tuple_inds), [] (const auto map_entry) -> std::size_t {return map_entry.second.idx;});
-
-  return {tuple_inds, delete_inds};
+  return MatchStatus::TUPLE;
 }
 
 template <class Data, class SourceId>
@@ -304,6 +366,7 @@ void FixedLagBuffer<Data, SourceId>::reset()
 {
   _data.clear();
   _buffer_time = Time{std::chrono::seconds{0}};
+  _watermark = Time{std::chrono::seconds{0}};
   _current_time = Time{std::chrono::seconds{0}};
 }
 
@@ -313,6 +376,12 @@ Time FixedLagBuffer<Data, SourceId>::getBufferTime() const
   return _buffer_time;
 }
 
+template <class Data, class SourceId>
+Time FixedLagBuffer<Data, SourceId>::getWatermark() const
+{
+  return _watermark;
+}
+
 template <class Data, class SourceId>
 Time FixedLagBuffer<Data, SourceId>::getCurrentTime() const
 {
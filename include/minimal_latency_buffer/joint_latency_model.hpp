@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <unordered_map>
+
+#include "minimal_latency_buffer/types.hpp"
+
+namespace minimal_latency_buffer
+{
+
+/**
+ * Tracks the correlation of latency excursions across sources.
+ *
+ * Each source provides the standardized residual of its latest latency sample (with respect to its own estimated
+ * latency distribution). Residuals of different sources whose measurement time stamps are close to each other are
+ * considered to be affected by the same network / host conditions, hence, their products are averaged into a pairwise
+ * correlation estimate.
+ *
+ * Based on the correlation, the latency distribution of a still missing sample can be conditioned on the residual
+ * already observed for a correlated source: z_missing | z_observed ~ N(rho * z_observed, 1 - rho^2).
+ */
+template <class SourceId>
+class JointLatencyModel
+{
+public:
+  /**
+   * Latency distribution of a missing sample conditioned on an observed residual (in units of its own stddev).
+   */
+  struct Conditioning
+  {
+    double mean_shift;
+    double stddev_factor;
+  };
+
+  explicit JointLatencyModel(JointLatencyParams params = {}) : _params{ params }
+  {
+  }
+
+  /**
+   * @param id                    Source of the latest sample.
+   * @param meas_time             Measurement time stamp of the latest sample.
+   * @param standardized_residual (latency - mean latency) / latency stddev of the latest sample.
+   */
+  void update(SourceId id, Time meas_time, double standardized_residual)
+  {
+    for (const auto& [other_id, other] : _latest_residuals)
+    {
+      if (other_id == id or std::chrono::abs(other.meas_time - meas_time) > _params.max_time_offset)
+      {
+        continue;
+      }
+
+      const double product = standardized_residual * other.residual;
+      updateCorrelation(_correlations[id][other_id], product);
+      updateCorrelation(_correlations[other_id][id], product);
+    }
+
+    _latest_residuals[id] = { meas_time, standardized_residual };
+  }
+
+  /**
+   * @return Correlation of the latency residuals of both sources (0 if not enough samples are available).
+   */
+  [[nodiscard]] double correlation(SourceId first, SourceId second) const
+  {
+    auto it = _correlations.find(first);
+    if (it == _correlations.end())
+    {
+      return 0;
+    }
+    auto pair_it = it->second.find(second);
+    if (pair_it == it->second.end() or pair_it->second.num_samples < MIN_SAMPLES)
+    {
+      return 0;
+    }
+    return std::clamp(pair_it->second.correlation, -1.0, 1.0);
+  }
+
+  /**
+   * Conditions the latency distribution of a missing sample on the most strongly correlated residual observed
+   * around its measurement time.
+   * @param id        Source of the missing sample.
+   * @param meas_time (Expected) measurement time stamp of the missing sample.
+   */
+  [[nodiscard]] std::optional<Conditioning> condition(SourceId id, Time meas_time) const
+  {
+    std::optional<Conditioning> best;
+    double best_correlation = _params.min_correlation;
+    for (const auto& [other_id, other] : _latest_residuals)
+    {
+      if (other_id == id or std::chrono::abs(other.meas_time - meas_time) > _params.max_time_offset)
+      {
+        continue;
+      }
+
+      const double rho = correlation(id, other_id);
+      if (std::abs(rho) < best_correlation)
+      {
+        continue;
+      }
+      best_correlation = std::abs(rho);
+      best = Conditioning{ .mean_shift = rho * other.residual, .stddev_factor = std::sqrt(1 - rho * rho) };
+    }
+    return best;
+  }
+
+  void reset()
+  {
+    _latest_residuals.clear();
+    _correlations.clear();
+  }
+
+private:
+  struct Residual
+  {
+    Time meas_time;
+    double residual;
+  };
+
+  struct Correlation
+  {
+    double correlation = 0;
+    std::size_t num_samples = 0;
+  };
+
+  void updateCorrelation(Correlation& entry, double product) const
+  {
+    entry.correlation = (entry.num_samples == 0) ? product : (1 - _params.alpha) * entry.correlation + _params.alpha * product;
+    entry.num_samples++;
+  }
+
+  JointLatencyParams _params;
+  std::unordered_map<SourceId, Residual> _latest_residuals;
+  std::unordered_map<SourceId, std::unordered_map<SourceId, Correlation>> _correlations;
+
+  // minimal number of residual pairs before a correlation is considered
+  static constexpr std::size_t MIN_SAMPLES = 10;
+};
+
+}  // namespace minimal_latency_buffer
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <list>
+#include <map>
 #include <vector>
 #include <algorithm>
 #include <ranges>
@@ -9,6 +11,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include "minimal_latency_buffer/joint_latency_model.hpp"
 #include "minimal_latency_buffer/stream_characteristics_estimator.hpp"
 #include "minimal_latency_buffer/types.hpp"
 
@@ -36,6 +39,7 @@ public:
   using Data_t = Data;
   using SourceId_t = SourceId;
   using Estimator = StreamCharacteristicsEstimator<Clock,Duration>;
+  using EstimatorMap = std::unordered_map<SourceId, Estimator>;
 
   using IndexList = std::vector<std::size_t>;
 
@@ -43,7 +47,16 @@ public:
   using PopReturn_t = PopReturn<TimeData_t>;
   using MeasTimeComparator_t = MeasTimeComparator<TimeData_t>;
 
-  using MatchingMap_t = MatchingMap<SourceId>;
+  using MatchingState_t = MatchingState<SourceId>;
+  using MatchGroup_t = MatchGroup<SourceId>;
+  using MissingMember_t = MissingMember<SourceId>;
+  using Chunk_t = Chunk<SourceId, Data>;
+  using Correction_t = Correction<TimeData_t>;
+  using MissingSample_t = MissingSample<SourceId>;
+  // merges a sample (second argument) into an aggregate (first argument)
+  using Aggregator = std::function<void(Data&, Data&&)>;
+  // receives the discarded samples (DiscardPolicy::CALLBACK)
+  using DiscardCallback = std::function<void(TimeData_t&&)>;
 
   struct Params
   {
@@ -63,14 +76,64 @@ public:
     // limit the maximal time the buffer waits for a sample (measurement_jitter + latency + latency_jitter)
     Duration max_total_wait_time = std::chrono::seconds(1000);
 
+    // parametrization of the per-source stream characteristics estimation
+    typename Estimator::Params estimator {};
+
     BatchParams batch {};
     MatchParams<SourceId> match {};
+
+    // per-source overrides of the parameters above (can be adjusted at runtime via setSourceParams())
+    std::unordered_map<SourceId, SourceParams> sources {};
+
+    // optional adaption of the wait confidence quantile based on the observed discard rates
+    DiscardControlParams discard_control {};
+
+    // optional consideration of latency correlations across sources
+    JointLatencyParams joint_latency {};
+
+    GridParams grid {};
+    AsOfParams<SourceId> asof {};
+
+    SpeculativeParams speculative {};
+
+    // reports every expired placeholder as missing sample (not supported for match groups and the ASOF mode)
+    bool report_missing_samples = false;
+
+    // handling of the samples which are neither released nor routed to the late data
+    DiscardPolicy discard_policy = DiscardPolicy::COLLECT;
   };
 
 
   explicit MinimalLatencyBuffer(Params params);
 
-  [[nodiscard]] PushReturn push(SourceId id, Time receipt_time, Time meas_time, Data&& data);
+  /**
+   * Creates a buffer reading the stream characteristics from externally updated estimators, i.e., the estimators are
+   * neither updated nor reset by this buffer (see SharedIngestBuffer).
+   * @param estimators Estimators of all sources (may be shared across several buffers).
+   * @param sources    Sources pushed into this buffer, solely these are waited for by the default match group.
+   * @throws std::invalid_argument if any source is delayed by a reorder window or a multi-part assembly, as the
+   *         external estimation is based on the undelayed reception.
+   */
+  MinimalLatencyBuffer(Params params, std::shared_ptr<EstimatorMap> estimators, std::vector<SourceId> sources);
+
+  /**
+   * @param cost Optional cost feature of the sample (e.g., payload size or number of points). If provided, the latency
+   *             is regressed on it, i.e., the waiting time is sized with respect to the expected cost.
+   */
+  [[nodiscard]] PushReturn push(SourceId id, Time receipt_time, Time meas_time, Data&& data,
+                                std::optional<double> cost = std::nullopt);
+
+  /**
+   * Pushes a single part of a measurement which is delivered within several parts (e.g., packets of a scan) sharing
+   * the same measurement time. The measurement is pushed as soon as all of its parts are received, i.e., the period
+   * and latency of the source are estimated with respect to the assembled measurements.
+   * @param part_index Index of the part within the measurement (parts may be received in any order).
+   * @param num_parts  Total number of parts of the measurement.
+   * @param cost       Optional cost feature of the part, the cost of the measurement is the sum over its parts.
+   */
+  [[nodiscard]] PushReturn pushPart(SourceId id, Time receipt_time, Time meas_time, Data&& part,
+                                    std::size_t part_index, std::size_t num_parts,
+                                    std::optional<double> cost = std::nullopt);
 
   PopReturn_t pop(Time time);
 
@@ -94,6 +157,13 @@ public:
    */
   [[nodiscard]] Time getEstimatedBufferTime() const;
 
+  /**
+   * Monotonic event time watermark, i.e., with the confidence configured within the parameters, no sample with an
+   * older measurement time will be released in the future (excluding new sources and corrections of the speculative
+   * release within the retraction window). Updated by every pop, even if no data is released.
+   */
+  [[nodiscard]] Time getWatermark() const;
+
   /**
    * @return Oldest reception time across all data that is currently hold back within the buffer.
    */
@@ -106,6 +176,56 @@ public:
   [[nodiscard]] Duration getEstimatedPeriodStddev(SourceId id) const;
   [[nodiscard]] Duration getEstimatedPeriodQuantile(SourceId id, double quantile) const;
 
+  /**
+   * Sets the parameter overrides of a single source without resetting the buffer.
+   *
+   * Note: the overrides are applied to all placeholders created afterwards, i.e., they are fully effective at the
+   *       latest after one update period of the source. The discard control of the source (if enabled) restarts
+   *       from the new overrides.
+   * @param id            Input source id.
+   * @param source_params Overrides replacing any previously configured overrides of this source.
+   */
+  void setSourceParams(SourceId id, SourceParams source_params);
+  void clearSourceParams(SourceId id);
+  [[nodiscard]] SourceParams getSourceParams(SourceId id) const;
+
+  /**
+   * Sets the aggregation of a decimated source, i.e., the samples dropped by the decimation are merged (in order of
+   * their reception) into the next stored sample of the source instead of being deleted.
+   * @param id         Input source id.
+   * @param aggregator Merges a dropped sample into the aggregate.
+   */
+  void setAggregator(SourceId id, Aggregator aggregator);
+
+  /**
+   * Sets the assembly of multi-part measurements of a source (required for measurements with more than one part).
+   * @param id        Input source id.
+   * @param assembler Merges a part into the assembled measurement (called in order of the part indices).
+   */
+  void setAssembler(SourceId id, Aggregator assembler);
+
+  /**
+   * @return Wait confidence quantile currently used for the given source (considers overrides and discard control).
+   */
+  [[nodiscard]] double getEffectiveWaitQuantile(SourceId id) const;
+
+  /**
+   * @return Number of samples of the given source dropped since they exceeded their maximal age at the release (see
+   *         SourceParams::max_age_at_release).
+   */
+  [[nodiscard]] std::size_t getNumberOfStaleSamples(SourceId id) const;
+
+  /**
+   * Sets the handling of the discarded samples for DiscardPolicy::CALLBACK (called during pop). As long as no callback
+   * is set, the discarded samples are reported within PopReturn::discarded_data.
+   */
+  void setDiscardCallback(DiscardCallback callback);
+
+  /**
+   * @return Number of discarded samples of the given source (solely counted for DiscardPolicy::COUNT).
+   */
+  [[nodiscard]] std::size_t getNumberOfDiscardedSamples(SourceId id) const;
+
   void reset();
 
 protected:
@@ -118,16 +238,246 @@ protected:
    * @return
    */
   [[nodiscard]] TimeData_t createPlaceholder(SourceId id, Time meas_time, std::size_t placeholder_index = 1) const;
+  /**
+   * Creates the placeholders following the provided element until the first one after the buffer time.
+   */
   [[nodiscard]] std::vector<TimeData_t> create_placeholders(TimeData_t& element,
+                                                            Time buffer_time,
                                                             std::size_t max_number = MAX_INSERTED_PLACEHOLDERS) const;
 
-  IndexList runBatching(IndexList ready_for_output_ids, Time time);
-  std::pair<IndexList, IndexList> runMatching(IndexList ready_for_output_ids);
+  /**
+   * @return Configured overrides of the given source (empty overrides if none are configured).
+   */
+  [[nodiscard]] const SourceParams& sourceParams(SourceId id) const;
+
+  /**
+   * Inserts a received sample (after passing the reorder stage of its source) into the queue.
+   */
+  void insertSample(SourceId id, Time receipt_time, Time meas_time, Data&& data, std::optional<double> cost);
+
+  /**
+   * Releases the samples of the reorder stages whose reorder window expired up to the given time in order of their
+   * measurement time.
+   */
+  void releaseReordered(Time time);
+
+  /**
+   * Updates the stream characteristics of a source with a received sample.
+   * @param matched_placeholder    Flags if the sample replaced one of the placeholders of the source.
+   * @param num_missed_placeholder Number of placeholders of the source which have been missed by the sample.
+   */
+  void updateEstimator(Estimator& estimator, SourceId id, Time receipt_time, Time meas_time, bool matched_placeholder,
+                       std::size_t num_missed_placeholder, std::optional<double> cost);
+
+  /**
+   * @throws std::invalid_argument if the overrides of a source are not supported by the buffer configuration.
+   */
+  void validateSourceParams(const SourceParams& source_params) const;
+
+  /**
+   * Appends a sample of a chunked source to its lane, the lane is blocked by a single placeholder for its next sample.
+   */
+  void pushChunked(SourceId id, Time receipt_time, Time meas_time, Data&& data, std::optional<double> cost);
+
+  /**
+   * @return Position of the placeholder blocking the lane of the chunked source within _data, if it is the only
+   *         placeholder of the source.
+   */
+  [[nodiscard]] std::optional<std::size_t> findLanePlaceholder(SourceId id) const;
+
+  /**
+   * Moves the lane samples up to the given time and prior to the frontier into chunks split at the measurement times
+   * of the output, lane samples older than the buffer time are discarded (or routed to the late data).
+   * @return Measurement time of the latest released lane sample (if any).
+   */
+  std::optional<Time> releaseLanes(const std::vector<TimeData_t>& output, Time time, Time frontier,
+                                   std::vector<Chunk_t>& chunks, std::vector<TimeData_t>& discarded_data,
+                                   std::vector<TimeData_t>& late_data);
+
+  /**
+   * Pushes all multi-part measurements whose assembly timeout expired up to the given time.
+   */
+  void releaseExpiredAssemblies(Time time);
+
+  /**
+   * Applies the decimation policy of the source to the sample which has just been pushed (after the estimator update).
+   */
+  void decimate(SourceId id, Time meas_time);
+
+  /**
+   * Releases the data according to the buffer mode (called by pop()).
+   */
+  PopReturn_t popData(Time time);
+
+  /**
+   * Advances the watermark to the earliest measurement time which may still be released.
+   */
+  void updateWatermark();
+
+  /**
+   * Removes the released samples (including the samples of chunks) exceeding the maximal age of their source at the
+   * given time, the batch starts and chunk positions are adjusted accordingly (not applied in the MATCH and ASOF mode).
+   */
+  void dropStale(PopReturn_t& result, Time time);
+
+  /**
+   * Handles a sample which is neither released nor routed to the late data according to the discard policy.
+   */
+  void discard(TimeData_t&& element, std::vector<TimeData_t>& discarded_data);
+
+  /**
+   * Reports an expired placeholder as missing sample (once per placeholder).
+   */
+  void reportMissingSample(const TimeData_t& placeholder, std::vector<MissingSample_t>& missing_samples);
+
+  /**
+   * Adapts the wait confidence quantile of a source after one of its samples was either output or discarded.
+   * @param id        Input source id.
+   * @param discarded Flags if the sample was discarded since it arrived after its placeholder expired.
+   */
+  void updateDiscardControl(SourceId id, bool discarded);
+
+  /**
+   * Shifts the expiration of a placeholder based on the latency residuals observed for correlated sources.
+   * @param placeholder Placeholder blocking the output.
+   * @return Offset added to the latest expected reception time of the placeholder.
+   */
+  [[nodiscard]] Duration jointDeadlineOffset(const TimeData_t& placeholder) const;
+
+  struct MatchResult
+  {
+    IndexList tuple_inds;
+    // samples which can not take part in any tuple anymore
+    IndexList delete_inds;
+    // members missing within partially released tuples, ref_position holds the index of the reference within _data
+    std::vector<MissingMember_t> missing_members;
+  };
+
+  struct BatchResult
+  {
+    IndexList output_inds;
+    // position of the first sample of every batch within output_inds
+    IndexList batch_starts;
+  };
+
+  /**
+   * Partitions the ready samples into consecutive windows of max_delta, all windows are released except for the last
+   * one as long as a pending placeholder may still fall into it.
+   */
+  BatchResult runBatching(const IndexList& ready_for_output_ids, Time time);
+  /**
+   * Releases the ready samples of all grid cycles ending prior to the frontier, i.e., the earliest measurement time
+   * which may still be received.
+   */
+  BatchResult runGridBatching(const IndexList& ready_for_output_ids, Time frontier);
+  MatchResult runMatching(IndexList ready_for_output_ids, const MatchGroup_t& group, Time time);
+
+  /**
+   * @return Partial release deadline of the group (falls back to the match parameters).
+   */
+  [[nodiscard]] std::optional<Duration> partialDeadline(const MatchGroup_t& group) const;
+  /**
+   * @return Tau tolerance of the group (falls back to the match parameters).
+   */
+  [[nodiscard]] std::optional<Duration> maxTau(const MatchGroup_t& group) const;
+
+  /**
+   * Matches the samples of all group members to a single reference sample, the result is stored within
+   * _matching_state. Samples exceeding the tau tolerance of the group are neither matched nor waited for.
+   * @param ready_for_output_ids Sorted indices of all samples which may be outputted.
+   * @param ref_pos              Position of the reference sample within ready_for_output_ids.
+   * @param begin_pos            First position within ready_for_output_ids considered for the matching.
+   * @param group                Sources taking part in the tuple.
+   */
+  MatchStatus matchReference(const IndexList& ready_for_output_ids, std::size_t ref_pos, std::size_t begin_pos,
+                             const MatchGroup_t& group);
+
+  /**
+   * Assigns the samples of all group members to the reference samples within the configured window such that the
+   * number of complete tuples is maximized at a minimal total time difference (tau).
+   *
+   * Each sample may only be assigned to a reference within one reference period, tuples are solely released for
+   * references whose candidates are final, i.e., compared to the greedy matching the release may be delayed by up to
+   * one reference period.
+   * @param ready_for_output_ids Sorted indices of all samples which may be outputted.
+   * @param group                Sources taking part in the tuples.
+   * @param ref_period           Estimated period of the reference stream.
+   */
+  MatchResult runAssignment(const IndexList& ready_for_output_ids, const MatchGroup_t& group, Duration ref_period);
+
+  /**
+   * MATCH mode with several match groups: every group releases its tuples independently of the other groups, i.e.,
+   * it solely waits for the placeholders of its own members.
+   */
+  PopReturn_t popGroups(Time time);
+
+  /**
+   * ASOF mode: releases the reference samples together with the latest samples of the other sources, the placeholders
+   * of the other sources are not waited for.
+   */
+  PopReturn_t popAsOf(Time time);
+
+  /**
+   * Collects the samples of the group members which are ready for output (creates the placeholders of all samples the
+   * group passes).
+   * @return Sorted indices of the ready samples and flag whether new placeholders have been created.
+   */
+  std::pair<IndexList, bool> groupReadyIndices(const MatchGroup_t& group, Time group_buffer_time, Time time);
 
   Params _params;
   std::vector<TimeData_t> _data;
-  std::unordered_map<SourceId, Estimator> _source_infos;
+  std::shared_ptr<EstimatorMap> _source_infos = std::make_shared<EstimatorMap>();
+  bool _external_estimation = false;  ///< the estimators are updated by the owner of _source_infos
+  std::optional<std::vector<SourceId>> _subscribed_sources;  ///< sources pushed by the owner of _source_infos
+  std::unordered_map<SourceId, double> _controlled_wait_quantiles;  ///< wait quantiles adapted by the discard control
+  JointLatencyModel<SourceId> _joint_latency;
+  MatchingState_t _matching_state;  ///< reused for every matched tuple to omit allocations
+  std::vector<Time> _group_buffer_times;  ///< measurement time up to which each match group has been processed
+  std::unordered_map<SourceId, std::vector<Time>> _group_released;  ///< queued samples already output by any group
+  std::vector<std::shared_ptr<const TimeData_t>> _asof_snapshots;  ///< latest sample of every non-reference source
+  std::vector<Time> _released_times;  ///< sorted measurement times released within the speculative retraction window
+  std::unordered_map<SourceId, Time> _reported_missing;  ///< measurement time of the latest reported missing sample
+  std::unordered_map<SourceId, std::size_t> _num_stale_samples;  ///< samples dropped by the staleness filter
+  std::unordered_map<SourceId, std::size_t> _num_discarded_samples;  ///< discarded samples (DiscardPolicy::COUNT)
+  DiscardCallback _discard_callback;
+
+  struct DecimationState
+  {
+    std::size_t counter{ 0 };     ///< number of received samples
+    std::optional<Data> aggregate;  ///< merged data of the dropped samples
+  };
+  std::unordered_map<SourceId, DecimationState> _decimation_states;
+  std::unordered_map<SourceId, Aggregator> _aggregators;
+  std::unordered_map<SourceId, Chunk_t> _lanes;  ///< pending samples of the chunked sources
+  std::unordered_map<SourceId, Time> _lane_placeholders;  ///< measurement time of the placeholder blocking each lane
+
+  struct ReorderedSample
+  {
+    Time receipt_time;
+    Time meas_time;
+    Data data;
+    std::optional<double> cost;
+  };
+  // samples within the reorder window of their source, sorted by their measurement time
+  std::unordered_map<SourceId, std::vector<ReorderedSample>> _reorder_stages;
+
+  struct Assembly
+  {
+    Time first_receipt_time;
+    std::size_t num_received{ 0 };
+    std::vector<std::optional<Data>> parts;
+    std::optional<double> cost;
+
+    /**
+     * Merges the received parts (in order of their part index) into a single measurement.
+     */
+    Data assemble(const Aggregator& assembler);
+  };
+  std::unordered_map<SourceId, std::map<Time, Assembly>> _assemblies;  ///< incomplete multi-part measurements
+  std::vector<TimeData_t> _dropped_assemblies;  ///< incomplete measurements dropped during push (discarded during pop)
+  std::unordered_map<SourceId, Aggregator> _assemblers;
   Time _buffer_time = Time{ std::chrono::seconds(0) };   ///< the time of the buffer, i.e., the time of the last msg pop
+  Time _watermark = Time{ std::chrono::seconds(0) };     ///< earliest measurement time which may still be released
   Time _current_time = Time{ std::chrono::seconds(0) };  ///< external time
 
 
@@ -142,13 +492,59 @@ protected:
 //////////////////////////////////////
 
 template <class SourceId, class DataT>
-MinimalLatencyBuffer<SourceId, DataT>::MinimalLatencyBuffer(Params params) : _params{ params }
+MinimalLatencyBuffer<SourceId, DataT>::MinimalLatencyBuffer(Params params) : _params{ params }, _joint_latency{ params.joint_latency }
+{
+  _group_buffer_times.resize(_params.match.groups.size(), _buffer_time);
+
+  if (_params.match.assignment_window > 0 and
+      (_params.match.partial_deadline or
+       std::any_of(_params.match.groups.begin(), _params.match.groups.end(),
+                   [](const auto& group) { return group.partial_deadline.has_value(); })))
+  {
+    throw std::invalid_argument("the optimal tuple assignment does not support a partial release deadline");
+  }
+
+  for (const auto& [id, source_params] : _params.sources)
+  {
+    validateSourceParams(source_params);
+  }
+
+  if constexpr (not std::is_copy_constructible_v<TimeData_t>)
+  {
+    // a sample of a source within several groups is output by each of them
+    const auto& groups = _params.match.groups;
+    for (std::size_t group_idx{ 0 }; group_idx < groups.size(); ++group_idx)
+    {
+      for (std::size_t other_idx{ group_idx + 1 }; other_idx < groups.size(); ++other_idx)
+      {
+        if (groups[other_idx].contains(groups[group_idx].reference_stream) or
+            std::any_of(groups[group_idx].sources.begin(), groups[group_idx].sources.end(),
+                        [&](const auto& id) { return groups[other_idx].contains(id); }))
+        {
+          throw std::invalid_argument("sources within several match groups require copyable data");
+        }
+      }
+    }
+  }
+}
+
+template <class SourceId, class DataT>
+MinimalLatencyBuffer<SourceId, DataT>::MinimalLatencyBuffer(Params params, std::shared_ptr<EstimatorMap> estimators,
+                                                            std::vector<DataT> sources)
+  : MinimalLatencyBuffer(std::move(params))
 {
+  _source_infos = std::move(estimators);
+  _external_estimation = true;
+  _subscribed_sources = std::move(sources);
+  for (const auto& [id, source_params] : _params.sources)
+  {
+    validateSourceParams(source_params);
+  }
 }
 
 template <class Data, class SourceId>
-auto MinimalLatencyBuffer<Data, SourceId>::push(SourceId id, Time receipt_time, Time meas_time, Data&& data)
-    -> PushReturn
+auto MinimalLatencyBuffer<Data, SourceId>::push(SourceId id, Time receipt_time, Time meas_time, Data&& data,
+                                                std::optional<double> cost) -> PushReturn
 
 {
   assert(std::is_sorted(_data.begin(), _data.end(), MeasTimeComparator_t()) && "Data queue is not sorted according to "
@@ -164,15 +560,45 @@ auto MinimalLatencyBuffer<Data, SourceId>::push(SourceId id, Time receipt_time,
   }
   _current_time = std::max(_current_time, receipt_time);
 
+  if (sourceParams(id).reorder_window)
+  {
+    auto& stage = _reorder_stages[id];
+    const auto insert_it = std::upper_bound(
+        stage.begin(), stage.end(), meas_time,
+        [](const Time time, const ReorderedSample& sample) { return time < sample.meas_time; });
+    stage.insert(insert_it, ReorderedSample{ receipt_time, meas_time, std::move(data), cost });
+  }
+  else
+  {
+    insertSample(id, receipt_time, meas_time, std::move(data), cost);
+  }
+  if (not _reorder_stages.empty())
+  {
+    releaseReordered(receipt_time);
+  }
+
+  return PushReturn::OK;
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::insertSample(SourceId id, Time receipt_time, Time meas_time, Data&& data,
+                                                        std::optional<double> cost)
+{
+  if (_params.mode == BufferMode::SINGLE and sourceParams(id).chunked)
+  {
+    pushChunked(id, receipt_time, meas_time, std::move(data), cost);
+    return;
+  }
+
   // index within _data to the best matching placeholder
   std::optional<std::size_t> best_ind;
   // number of missed placeholder during best_fit search
   std::size_t num_missed_placeholder{0};
 
-  auto source_estimator_it = _source_infos.find(id);
-  if (source_estimator_it == _source_infos.end())
+  auto source_estimator_it = _source_infos->find(id);
+  if (source_estimator_it == _source_infos->end())
   {
-    _source_infos.emplace(id, Estimator{ receipt_time, meas_time });
+    _source_infos->emplace(id, Estimator{ receipt_time, meas_time, _params.estimator });
     _data.push_back(TimeData_t(id, meas_time, receipt_time, meas_time, receipt_time, std::move(data)));
   }
   else
@@ -213,7 +639,7 @@ auto MinimalLatencyBuffer<Data, SourceId>::push(SourceId id, Time receipt_time,
       element.data = std::move(data);
       element.meas_time = meas_time;
       element.receipt_time = receipt_time;  // mainly for debugging / evaluation
-      std::vector<TimeData_t> new_placeholders = create_placeholders(element);
+      std::vector<TimeData_t> new_placeholders = create_placeholders(element, _buffer_time);
       _data.insert(_data.end(),
                    std::make_move_iterator(new_placeholders.begin()),
                    std::make_move_iterator(new_placeholders.end()));
@@ -222,34 +648,15 @@ auto MinimalLatencyBuffer<Data, SourceId>::push(SourceId id, Time receipt_time,
     {
       // initialize a new element within the queue
       TimeData_t new_element = TimeData_t(id, meas_time, receipt_time, meas_time, receipt_time, std::move(data));
-      std::vector<TimeData_t> new_placeholders = create_placeholders(new_element);
+      std::vector<TimeData_t> new_placeholders = create_placeholders(new_element, _buffer_time);
       _data.insert(_data.end(),
                    std::make_move_iterator(new_placeholders.begin()),
                    std::make_move_iterator(new_placeholders.end()));
       _data.push_back(std::move(new_element));
     }
 
-    try
-    {
-      if (not source_estimator_it->second.isInitialized())
-      {
-        // do not consider num_missed_placeholder if not initialized before
-        source_estimator_it->second.update(receipt_time, meas_time);
-      }
-      else if (best_ind)
-      {
-        source_estimator_it->second.update(receipt_time, meas_time, num_missed_placeholder);
-      }
-      else
-      {
-        // in this case, num_missed_placeholder may be incorrect -> only update latency
-        source_estimator_it->second.updateLatencyOnly(receipt_time, meas_time);
-      }
-    }
-    catch (const std::runtime_error &e)
-    {
-//      std::cout << "Skipping sample for estimator update, due to failure during attempted update: \n" << e.what() << std::endl;
-    }
+    updateEstimator(source_estimator_it->second, id, receipt_time, meas_time, best_ind.has_value(),
+                    num_missed_placeholder, cost);
 
     // delete older no longer needed placeholders
     std::vector<TimeData_t> cleaned_data;
@@ -269,336 +676,1584 @@ auto MinimalLatencyBuffer<Data, SourceId>::push(SourceId id, Time receipt_time,
     _data = std::move(cleaned_data);
   }
 
+  if (sourceParams(id).decimation.policy != DecimationPolicy::NONE)
+  {
+    decimate(id, meas_time);
+  }
+
   // Improvement note: could potentially be skipped if insertion of new elements happens at the right place
   std::sort(_data.begin(), _data.end(), MeasTimeComparator_t());
+}
 
-  return PushReturn::OK;
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::releaseReordered(Time time)
+{
+  for (auto& [id, stage] : _reorder_stages)
+  {
+    const Duration window = sourceParams(id).reorder_window.value_or(Duration(0));
+    // the latest sample whose window expired releases all samples measured before it as well
+    const auto due_it = std::find_if(stage.rbegin(), stage.rend(), [&](const ReorderedSample& sample) {
+      return sample.receipt_time + window <= time;
+    });
+    const auto num_released = std::distance(due_it, stage.rend());
+    for (auto it = stage.begin(); it != stage.begin() + num_released; ++it)
+    {
+      // the window delay is considered as part of the latency of the source
+      insertSample(id, std::min(it->receipt_time + window, time), it->meas_time, std::move(it->data), it->cost);
+    }
+    stage.erase(stage.begin(), stage.begin() + num_released);
+  }
 }
 
 template <class Data, class SourceId>
-MinimalLatencyBuffer<Data, SourceId>::PopReturn_t MinimalLatencyBuffer<Data, SourceId>::pop(Time time)
+void MinimalLatencyBuffer<Data, SourceId>::updateEstimator(Estimator& estimator, SourceId id, Time receipt_time,
+                                                           Time meas_time, bool matched_placeholder,
+                                                           std::size_t num_missed_placeholder,
+                                                           std::optional<double> cost)
 {
-  assert(std::is_sorted(_data.begin(), _data.end(), MeasTimeComparator_t()) && "Data queue is not sorted according to "
-                                                                               "meas timestamps!");
+  // the residual is evaluated prior to the estimator update to be consistent with the evaluation of placeholders
+  if (_params.joint_latency.enabled and estimator.isInitialized() and estimator.latency_stddev().count() > 0)
+  {
+    const auto residual = (receipt_time - meas_time) - estimator.latency();
+    _joint_latency.update(id, meas_time, static_cast<double>(residual.count()) / static_cast<double>(estimator.latency_stddev().count()));
+  }
+  if (_external_estimation)
+  {
+    return;
+  }
 
-  // assumption: pop and push are only called with increasing time stamps as they should follow some real clock
-  if (time < _current_time)
+  try
   {
-    // error: either pop() or push() have already been called with a later time
-    return { _buffer_time, {}, {} };
+    if (not estimator.isInitialized())
+    {
+      // do not consider num_missed_placeholder if not initialized before
+      estimator.update(receipt_time, meas_time, 0, cost);
+    }
+    else if (matched_placeholder or estimator.usesClockModel())
+    {
+      // the clock model does not rely on the number of missed placeholders
+      estimator.update(receipt_time, meas_time, num_missed_placeholder, cost);
+    }
+    else
+    {
+      // in this case, num_missed_placeholder may be incorrect -> only update latency
+      estimator.updateLatencyOnly(receipt_time, meas_time, cost);
+    }
+  }
+  catch (const std::runtime_error &e)
+  {
+//    std::cout << "Skipping sample for estimator update, due to failure during attempted update: \n" << e.what() << std::endl;
   }
+}
 
-  // iterate through the queue and pop all elements until we reach the first placeholder
-  std::vector<std::size_t> output_inds;
-  std::vector<std::size_t> discard_inds;
-  std::vector<std::size_t> delete_inds;
-  std::vector<TimeData_t> cleaned_data;
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::pushChunked(SourceId id, Time receipt_time, Time meas_time, Data&& data,
+                                                       std::optional<double> cost)
+{
+  Chunk_t& lane = _lanes[id];
+  lane.id = id;
+  // a late sample solely requires a sorted insertion, it is discarded during the next pop
+  const bool in_order = lane.empty() or lane.meas_times.back() <= meas_time;
 
-  for (std::size_t i = 0; i < _data.size(); ++i)
+  auto source_estimator_it = _source_infos->find(id);
+  if (source_estimator_it == _source_infos->end())
   {
-    TimeData_t& element = _data.at(i);
-    // _data may start with samples that are older than our last output --> discard these elements
-    // possible if, e.g., we stopped waiting for data, but it was received a little later
-    if (element.meas_time < _buffer_time)
+    _source_infos->emplace(id, Estimator{ receipt_time, meas_time, _params.estimator });
+  }
+  else
+  {
+    // the lane is tracked by a single placeholder (more only remain if the source stalled during pop)
+    const Duration half_period = source_estimator_it->second.period() / 2;
+    bool matched_placeholder{ false };
+    bool pending_placeholder{ false };
+    std::size_t num_missed_placeholder{ 0 };
+    // position of the tracked placeholder within _data, which is reused for the next expected sample
+    std::optional<std::size_t> placeholder_idx;
+    if (in_order)
     {
-      // only delete non placeholder here, placeholders are handeled during push
-      if (not element.is_placeholder())
+      placeholder_idx = findLanePlaceholder(id);
+      if (placeholder_idx)
       {
-        discard_inds.push_back(i);
-        delete_inds.push_back(i);
+        const Time placeholder_meas_time = _data.at(*placeholder_idx).meas_time;
+        pending_placeholder = placeholder_meas_time >= meas_time + half_period;
+        matched_placeholder = not pending_placeholder and placeholder_meas_time > meas_time - half_period;
+        num_missed_placeholder = pending_placeholder or matched_placeholder ? 0 : 1;
+      }
+      else if (_lane_placeholders.contains(id))
+      {
+        // the source stalled during pop, i.e., the placeholder has been followed by further ones
+        _lane_placeholders.erase(id);
+        std::erase_if(_data, [&](const TimeData_t& sample) {
+          if (sample.id != id or not sample.is_placeholder())
+          {
+            return false;
+          }
+          if (sample.meas_time >= meas_time + half_period)
+          {
+            pending_placeholder = true;
+            return false;
+          }
+          if (sample.meas_time > meas_time - half_period)
+          {
+            matched_placeholder = true;
+          }
+          else
+          {
+            ++num_missed_placeholder;
+          }
+          return true;
+        });
       }
     }
-    else
+
+    updateEstimator(source_estimator_it->second, id, receipt_time, meas_time, matched_placeholder,
+                    num_missed_placeholder, cost);
+
+    if (in_order and not pending_placeholder)
     {
-      if (element.is_placeholder()){
-        if (element.receipt_time >= time)
-        {
-          break;
-        }
-      }
-      else
+      if (source_estimator_it->second.isInitialized() and not sourceParams(id).best_effort)
       {
-        if (element.meas_time > time)
+        TimeData_t placeholder = createPlaceholder(id, meas_time);
+        _lane_placeholders[id] = placeholder.meas_time;
+        if (placeholder_idx)
         {
-//          std::cout << "next element with meas_time: " << element.meas_time << std::endl;
-          break;
+          // moves the placeholder to its new position instead of an erase and insert over the whole queue
+          const auto placeholder_it = _data.begin() + *placeholder_idx;
+          if (MeasTimeComparator_t()(*placeholder_it, placeholder))
+          {
+            const auto insert_it =
+                std::upper_bound(placeholder_it + 1, _data.end(), placeholder, MeasTimeComparator_t());
+            *placeholder_it = std::move(placeholder);
+            std::rotate(placeholder_it, placeholder_it + 1, insert_it);
+          }
+          else
+          {
+            const auto insert_it = std::upper_bound(_data.begin(), placeholder_it, placeholder, MeasTimeComparator_t());
+            *placeholder_it = std::move(placeholder);
+            std::rotate(insert_it, placeholder_it, placeholder_it + 1);
+          }
         }
         else
         {
-          output_inds.push_back(i);
+          const auto insert_it = std::upper_bound(_data.begin(), _data.end(), placeholder, MeasTimeComparator_t());
+          _data.insert(insert_it, std::move(placeholder));
         }
       }
+      else if (placeholder_idx)
+      {
+        _data.erase(_data.begin() + *placeholder_idx);
+        _lane_placeholders.erase(id);
+      }
     }
-
-    std::vector<TimeData_t> new_placeholders = create_placeholders(element);
-    if (not new_placeholders.empty())
-    {
-      time = std::min(time, new_placeholders.back().meas_time);
-    }
-    std::move(new_placeholders.begin(), new_placeholders.end(), std::back_inserter(cleaned_data));
   }
 
-  // batch mode handling
-  if (_params.mode == BufferMode::BATCH and not output_inds.empty())
+  if (in_order)
   {
-    output_inds = runBatching(output_inds, time);
+    lane.meas_times.push_back(meas_time);
+    lane.receipt_times.push_back(receipt_time);
+    lane.data.push_back(std::move(data));
   }
-  else if (_params.mode == BufferMode::MATCH and not output_inds.empty())
+  else
   {
-    // elements which would require deletion are automatically deleted during push/pop since buffer_time advances
-    auto out_and_delete = runMatching(output_inds);
-    output_inds = std::move(out_and_delete.first);
-    std::copy(out_and_delete.second.begin(), out_and_delete.second.end(), std::back_inserter(delete_inds));
-    std::move(out_and_delete.second.begin(), out_and_delete.second.end(), std::back_inserter(discard_inds));
+    const auto offset = std::distance(
+        lane.meas_times.begin(), std::upper_bound(lane.meas_times.begin(), lane.meas_times.end(), meas_time));
+    lane.meas_times.insert(lane.meas_times.begin() + offset, meas_time);
+    lane.receipt_times.insert(lane.receipt_times.begin() + offset, receipt_time);
+    lane.data.insert(lane.data.begin() + offset, std::move(data));
   }
+}
 
-  // consider all samples in _data and either output, keep or discard them.
-  std::vector<TimeData_t> output;
-  output.reserve(output_inds.size());
-  // discarded data is only used for debug purposes and allows the user to gain insights
-  std::vector<TimeData_t> discarded_data;
-  discarded_data.reserve(discard_inds.size());
+template <class Data, class SourceId>
+std::optional<std::size_t> MinimalLatencyBuffer<Data, SourceId>::findLanePlaceholder(SourceId id) const
+{
+  auto tracked_it = _lane_placeholders.find(id);
+  if (tracked_it == _lane_placeholders.end())
+  {
+    return std::nullopt;
+  }
+  const auto lower = std::partition_point(_data.begin(), _data.end(),
+                                          [&](const TimeData_t& sample) { return sample.meas_time < tracked_it->second; });
+  for (auto it = lower; it != _data.end() and it->meas_time == tracked_it->second; ++it)
+  {
+    // a placeholder which created its successors during pop does not track the lane on its own anymore
+    if (it->id == id and it->is_placeholder() and not it->created_placeholder)
+    {
+      return std::distance(_data.begin(), it);
+    }
+  }
+  return std::nullopt;
+}
 
-  for (const std::size_t idx : output_inds)
+template <class Data, class SourceId>
+auto MinimalLatencyBuffer<Data, SourceId>::pushPart(SourceId id, Time receipt_time, Time meas_time, Data&& part,
+                                                    std::size_t part_index, std::size_t num_parts,
+                                                    std::optional<double> cost) -> PushReturn
+{
+  if (_current_time - receipt_time > _params.reset_threshold)
   {
-    output.push_back(std::move(_data.at(idx)));
+    reset();
+    return PushReturn::RESET;
   }
-  for (const std::size_t idx : discard_inds)
+  if (part_index >= num_parts)
   {
-    discarded_data.push_back(std::move(_data.at(idx)));
+    throw std::out_of_range("part index exceeds the number of parts of the measurement");
   }
+  if (num_parts > 1 and not _assemblers.contains(id))
+  {
+    throw std::logic_error("multi-part measurements require an assembler of their source");
+  }
+  releaseExpiredAssemblies(receipt_time);
+  _current_time = std::max(_current_time, receipt_time);
 
-  // all output indices must be deleted as well
-  delete_inds.insert(delete_inds.end(), output_inds.begin(), output_inds.end());
-  remove_indices(_data, delete_inds.begin(), delete_inds.end());
+  auto& source_assemblies = _assemblies[id];
+  Assembly& assembly = source_assemblies[meas_time];
+  if (assembly.num_received == 0)
+  {
+    assembly.first_receipt_time = receipt_time;
+  }
+  assembly.parts.resize(std::max(assembly.parts.size(), num_parts));
+  if (not assembly.parts[part_index])
+  {
+    ++assembly.num_received;
+  }
+  assembly.parts[part_index] = std::move(part);
+  if (cost)
+  {
+    assembly.cost = assembly.cost.value_or(0.0) + *cost;
+  }
 
-  // append all generated samples to the data buffer prior to sorting it
-  std::move(cleaned_data.begin(), cleaned_data.end(), std::back_inserter(_data));
+  if (assembly.num_received < assembly.parts.size())
+  {
+    return PushReturn::OK;
+  }
 
-  std::sort(_data.begin(), _data.end(), MeasTimeComparator_t());
-  // advance our internal buffer time to the last output element (if we later receive anything with an earlier
-  // measurement time stamp (e.g. new sensor)) we have to discard it because we otherwise would forward an
-  // out-of-sequence measurement with respect to the data we already returned
-  if (not output.empty())
+  Data data = assembly.assemble(_assemblers[id]);
+  const std::optional<double> assembly_cost = assembly.cost;
+  source_assemblies.erase(meas_time);
+  if (not sourceParams(id).assembly_timeout)
   {
-    _buffer_time = output.back().meas_time;
+    // older incomplete measurements would not be in sequence anymore, they are discarded with the next pop
+    const auto older_end = source_assemblies.lower_bound(meas_time);
+    if (_params.discard_policy != DiscardPolicy::DROP)
+    {
+      for (auto it = source_assemblies.begin(); it != older_end; ++it)
+      {
+        _dropped_assemblies.emplace_back(id, it->first, it->second.first_receipt_time, it->first,
+                                         it->second.first_receipt_time, it->second.assemble(_assemblers[id]));
+      }
+    }
+    source_assemblies.erase(source_assemblies.begin(), older_end);
   }
 
-  return { _buffer_time, std::move(output), std::move(discarded_data) };
+  return push(id, receipt_time, meas_time, std::move(data), assembly_cost);
 }
 
 template <class Data, class SourceId>
-MinimalLatencyBuffer<Data,SourceId>::IndexList MinimalLatencyBuffer<Data, SourceId>::runBatching(IndexList ready_for_output_ids, Time time)
+void MinimalLatencyBuffer<Data, SourceId>::releaseExpiredAssemblies(Time time)
 {
-  const auto batch_start_time = _data.at(ready_for_output_ids.front()).meas_time;
+  struct Expired
+  {
+    SourceId id;
+    Time receipt_time;
+    Time meas_time;
+    Data data;
+    std::optional<double> cost;
+  };
+  std::vector<Expired> expired;
 
-  // check whether it is worth waiting for the next input to form a batch
-  bool found_placeholder = false;
-  const auto offset_iter = _data.begin() + ready_for_output_ids.back();
-  for (auto iter = offset_iter; iter != _data.end(); ++iter)
+  for (auto& [id, source_assemblies] : _assemblies)
   {
-    if (not iter->is_placeholder())
+    const std::optional<Duration> timeout = sourceParams(id).assembly_timeout;
+    if (not timeout)
     {
       continue;
     }
+    for (auto it = source_assemblies.begin(); it != source_assemblies.end();)
+    {
+      const Time expiration = it->second.first_receipt_time + *timeout;
+      if (expiration > time)
+      {
+        ++it;
+        continue;
+      }
+      // a late expiration (e.g., without any pop in between) must not appear as jump back in time
+      expired.push_back({ id, std::max(expiration, _current_time), it->first, it->second.assemble(_assemblers[id]),
+                          it->second.cost });
+      it = source_assemblies.erase(it);
+    }
+  }
 
-    if (iter->earliest_estimated_meas_time - batch_start_time < _params.batch.max_delta and
-        iter->latest_receipt_time > time)
+  // the incomplete measurements are received at the expiration of their timeout
+  std::sort(expired.begin(), expired.end(),
+            [](const Expired& first, const Expired& second) { return first.receipt_time < second.receipt_time; });
+  for (Expired& measurement : expired)
+  {
+    if (push(measurement.id, measurement.receipt_time, measurement.meas_time, std::move(measurement.data),
+             measurement.cost) == PushReturn::RESET)
     {
-      found_placeholder = true;
-      break;
+      return;
+    }
+  }
+}
+
+template <class Data, class SourceId>
+Data MinimalLatencyBuffer<Data, SourceId>::Assembly::assemble(const Aggregator& assembler)
+{
+  std::optional<Data> data;
+  for (std::optional<Data>& assembly_part : parts)
+  {
+    if (not assembly_part)
+    {
+      continue;
+    }
+    if (data)
+    {
+      assembler(*data, std::move(*assembly_part));
+    }
+    else
+    {
+      data = std::move(assembly_part);
     }
   }
+  return std::move(*data);
+}
 
-  if (found_placeholder)
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::PopReturn_t MinimalLatencyBuffer<Data, SourceId>::pop(Time time)
+{
+  PopReturn_t result = popData(time);
+  for (TimeData_t& element : _dropped_assemblies)
+  {
+    discard(std::move(element), result.discarded_data);
+  }
+  _dropped_assemblies.clear();
+  const bool filter_stale = std::any_of(_params.sources.begin(), _params.sources.end(), [](const auto& source) {
+    return source.second.max_age_at_release.has_value();
+  });
+  if (filter_stale and _params.mode != BufferMode::MATCH and _params.mode != BufferMode::ASOF)
   {
-    // prevent output of ready data elements
-    return {};
+    dropStale(result, time);
   }
-  return ready_for_output_ids;
+  updateWatermark();
+  result.watermark = _watermark;
+  return result;
 }
 
 template <class Data, class SourceId>
-std::pair<typename MinimalLatencyBuffer<Data,SourceId>::IndexList, typename MinimalLatencyBuffer<Data,SourceId>::IndexList> MinimalLatencyBuffer<Data, SourceId>::runMatching(IndexList ready_for_output_ids)
+MinimalLatencyBuffer<Data, SourceId>::PopReturn_t MinimalLatencyBuffer<Data, SourceId>::popData(Time time)
 {
-//  std::cout << "running matching" << std::endl;
+  assert(std::is_sorted(_data.begin(), _data.end(), MeasTimeComparator_t()) && "Data queue is not sorted according to "
+                                                                               "meas timestamps!");
 
-  IndexList tuple_inds;
-  IndexList delete_inds;
+  // assumption: pop and push are only called with increasing time stamps as they should follow some real clock
+  if (time < _current_time)
+  {
+    // error: either pop() or push() have already been called with a later time
+    return { _buffer_time, {}, {} };
+  }
+  if (not _assemblies.empty())
+  {
+    releaseExpiredAssemblies(time);
+  }
+  if (not _reorder_stages.empty())
+  {
+    releaseReordered(time);
+  }
 
-  // sort output inds to omit full for loops
-  std::sort(ready_for_output_ids.begin(), ready_for_output_ids.end());
+  if (_params.mode == BufferMode::MATCH and not _params.match.groups.empty())
+  {
+    return popGroups(time);
+  }
+  if (_params.mode == BufferMode::ASOF)
+  {
+    return popAsOf(time);
+  }
 
+  // iterate through the queue and pop all elements until we reach the first placeholder
+  std::vector<std::size_t> output_inds;
+  std::vector<std::size_t> discard_inds;
+  std::vector<std::size_t> late_inds;
+  std::vector<std::size_t> delete_inds;
+  std::vector<TimeData_t> cleaned_data;
+  std::vector<MissingMember_t> missing_members;
+  std::vector<std::size_t> batch_starts;
+  std::vector<std::size_t> correction_inds;
+  std::vector<MissingSample_t> missing_samples;
+  const bool speculative = _params.mode == BufferMode::SINGLE and _params.speculative.enabled;
+  // earliest measurement time which may still be received
+  Time frontier = Time::max();
 
-  //////////////////////////////////////////////////
-  // find reference frame (oldest in buffer which may be outputted)
-  //////////////////////////////////////////////////
-  bool found_ref{false};
-  bool found_next_ref{false};
-  std::size_t ref_idx{0};
-  Time oldest_ref_meas_time{ std::chrono::seconds(0) };
-  Time next_ref_meas_time{ std::chrono::seconds(0) };
-  for (auto const& idx : ready_for_output_ids)
+  for (std::size_t i = 0; i < _data.size(); ++i)
   {
-    const TimeData_t &element = _data.at(idx);
-    if (element.id == _params.match.reference_stream)
+    TimeData_t& element = _data.at(i);
+    // _data may start with samples that are older than our last output --> discard these elements
+    // possible if, e.g., we stopped waiting for data, but it was received a little later
+    if (element.meas_time < _buffer_time)
     {
-      if (not found_ref)
+      // only delete non placeholder here, placeholders are handeled during push
+      if (element.is_placeholder())
       {
-//        std::cout << "found valid ref" << std::endl;
-        found_ref = true;
-        ref_idx = idx;
-        oldest_ref_meas_time = element.meas_time;
+        // the sample may still be received prior to its deadline (e.g., as correction of the speculative release)
+        Time deadline = element.receipt_time;
+        if (_params.joint_latency.enabled)
+        {
+          deadline += jointDeadlineOffset(element);
+        }
+        if (deadline < time)
+        {
+          reportMissingSample(element, missing_samples);
+        }
       }
       else
       {
-//        std::cout << "found valid next" << std::endl;
-        found_next_ref = true;
-        next_ref_meas_time = element.meas_time;
-        break;
+        // the speculative release corrects late samples instead of discarding them
+        if (speculative and element.meas_time >= _buffer_time - _params.speculative.max_retraction)
+        {
+          correction_inds.push_back(i);
+        }
+        else if (sourceParams(element.id).late_routing == LateRouting::LATE)
+        {
+          late_inds.push_back(i);
+        }
+        else
+        {
+          discard_inds.push_back(i);
+        }
+        delete_inds.push_back(i);
+      }
+    }
+    else
+    {
+      if (element.is_placeholder()){
+        Time deadline = element.receipt_time;
+        if (_params.joint_latency.enabled)
+        {
+          deadline += jointDeadlineOffset(element);
+        }
+        if (_params.mode == BufferMode::MATCH and _params.match.partial_deadline)
+        {
+          // missing members do not block the release of partial tuples beyond their deadline
+          deadline = std::min(deadline, element.meas_time + *_params.match.partial_deadline);
+        }
+        // the speculative release does not wait for any placeholder
+        if (deadline >= time and not speculative)
+        {
+          frontier = element.meas_time;
+          break;
+        }
+        if (deadline < time)
+        {
+          reportMissingSample(element, missing_samples);
+        }
+      }
+      else
+      {
+        if (element.meas_time > time)
+        {
+//          std::cout << "next element with meas_time: " << element.meas_time << std::endl;
+          frontier = element.meas_time;
+          break;
+        }
+        else
+        {
+          output_inds.push_back(i);
+        }
       }
     }
+
+    std::vector<TimeData_t> new_placeholders = create_placeholders(element, _buffer_time);
+    if (not new_placeholders.empty())
+    {
+      time = std::min(time, new_placeholders.back().meas_time);
+      frontier = std::min(frontier, new_placeholders.back().meas_time);
+    }
+    std::move(new_placeholders.begin(), new_placeholders.end(), std::back_inserter(cleaned_data));
+  }
+
+  // batch mode handling
+  if (_params.mode == BufferMode::BATCH and not output_inds.empty())
+  {
+    BatchResult batch_result = runBatching(output_inds, time);
+    output_inds = std::move(batch_result.output_inds);
+    batch_starts = std::move(batch_result.batch_starts);
   }
-  if (not found_ref)
+  else if (_params.mode == BufferMode::GRID and not output_inds.empty())
   {
-//    std::cout << "no valid ref found" << std::endl;
-    return {tuple_inds, delete_inds};
+    // without any anticipated sample, solely samples up to the current time may have been acquired
+    BatchResult batch_result = runGridBatching(output_inds, frontier == Time::max() ? time : frontier);
+    output_inds = std::move(batch_result.output_inds);
+    batch_starts = std::move(batch_result.batch_starts);
   }
-
-  if (not found_next_ref)
+  else if (_params.mode == BufferMode::MATCH and not output_inds.empty())
   {
-    auto est_it = _source_infos.find(_params.match.reference_stream);
-    if (est_it != _source_infos.end())
+    // elements which would require deletion are automatically deleted during push/pop since buffer_time advances
+    // without configured groups, the reference is matched with all sources
+    // (the estimators shared with other buffers may contain sources which are never pushed into this buffer)
+    MatchGroup_t group{ .reference_stream = _params.match.reference_stream, .sources = {} };
+    const auto add_member = [&](const SourceId& id) {
+      // best effort sources never hold back the release of a tuple
+      if (id != group.reference_stream and not sourceParams(id).best_effort)
+      {
+        group.sources.push_back(id);
+      }
+    };
+    if (_subscribed_sources)
     {
-      next_ref_meas_time = oldest_ref_meas_time + est_it->second.period();
+      std::for_each(_subscribed_sources->begin(), _subscribed_sources->end(), add_member);
+    }
+    else
+    {
+      for (const auto& [id, estimator] : *_source_infos)
+      {
+        add_member(id);
+      }
+    }
+    MatchResult match_result = runMatching(output_inds, group, time);
+    output_inds = std::move(match_result.tuple_inds);
+    std::copy(match_result.delete_inds.begin(), match_result.delete_inds.end(), std::back_inserter(delete_inds));
+    std::move(match_result.delete_inds.begin(), match_result.delete_inds.end(), std::back_inserter(discard_inds));
+    // the missing members refer to the position of their reference sample within the output
+    for (MissingMember_t &missing : match_result.missing_members)
+    {
+      const auto ref_it = std::find(output_inds.begin(), output_inds.end(), missing.ref_position);
+      missing.ref_position = std::distance(output_inds.begin(), ref_it);
     }
+    missing_members = std::move(match_result.missing_members);
   }
 
-//  std::cout << "times: " << oldest_ref_meas_time << " | " << next_ref_meas_time << std::endl;
-//  std::cout << "avail outputs: " << ready_for_output_ids.size() << std::endl;
-//  std::cout << "avail data: " << _data.size() << std::endl;
-
-  // assumption: no overlapping data within single stream (interval/meas_time)
-  // then using the earliest_meas_time is sufficient when considering placeholders
+  // consider all samples in _data and either output, keep or discard them.
+  std::vector<TimeData_t> output;
+  output.reserve(output_inds.size());
+  // discarded data is only used for debug purposes and allows the user to gain insights
+  std::vector<TimeData_t> discarded_data;
+  if (_params.discard_policy == DiscardPolicy::COLLECT)
+  {
+    discarded_data.reserve(discard_inds.size());
+  }
+  std::vector<TimeData_t> late_data;
+  late_data.reserve(late_inds.size());
 
-  //////////////////////////////////////////////////
-  // check for fitting matches
-  //////////////////////////////////////////////////
-  MatchingMap_t matching_map;
-  MatchMapEntry &ref_el = matching_map[_params.match.reference_stream];
-  ref_el.idx = ref_idx;
-  ref_el.tau = 0;
-  // remember the highest index used in _data
-  // later on it is sufficient to start there, since _data is sorted
-  std::size_t latest_data_idx{0};
-  for (std::size_t out_idx{0}; out_idx < ready_for_output_ids.size(); ++out_idx)
+  if (_params.discard_control.enabled)
   {
-    const std::size_t idx = ready_for_output_ids[out_idx];
-    const TimeData_t &element = _data.at(idx);
-    latest_data_idx = idx;
+    for (const std::size_t idx : output_inds)
+    {
+      updateDiscardControl(_data.at(idx).id, false);
+    }
+    for (const auto* inds : { &discard_inds, &late_inds })
+    {
+      for (const std::size_t idx : *inds)
+      {
+        // only samples which were waited for, but arrived after the expiration of their placeholder are misses
+        const TimeData_t &element = _data.at(idx);
+        if (element.receipt_time > element.latest_receipt_time)
+        {
+          updateDiscardControl(element.id, true);
+        }
+      }
+    }
+  }
 
-    if (element.id == _params.match.reference_stream)
+  for (const std::size_t idx : output_inds)
+  {
+    output.push_back(std::move(_data.at(idx)));
+  }
+  if (_params.discard_policy != DiscardPolicy::DROP)
+  {
+    for (const std::size_t idx : discard_inds)
     {
-      // omit taking a newer reference, as only the oldest may be considered
-      continue;
+      discard(std::move(_data.at(idx)), discarded_data);
     }
+  }
+  for (const std::size_t idx : late_inds)
+  {
+    late_data.push_back(std::move(_data.at(idx)));
+  }
+  std::vector<Correction_t> corrections;
+  corrections.reserve(correction_inds.size());
+  for (const std::size_t idx : correction_inds)
+  {
+    TimeData_t &element = _data.at(idx);
+    const auto successor_it = std::upper_bound(_released_times.begin(), _released_times.end(), element.meas_time);
+    const std::size_t num_retracted = std::distance(successor_it, _released_times.end());
+    _released_times.insert(successor_it, element.meas_time);
+    corrections.push_back({ std::move(element), num_retracted });
+  }
 
-    auto current_diff = std::chrono::abs(element.meas_time - oldest_ref_meas_time);
-    auto next_diff = std::chrono::abs(element.meas_time - next_ref_meas_time);
+  // all output indices must be deleted as well
+  delete_inds.insert(delete_inds.end(), output_inds.begin(), output_inds.end());
+  remove_indices(_data, delete_inds.begin(), delete_inds.end());
 
-    // check if it fits better to the next reference sample
-    if (next_diff < current_diff)
+  // append all generated samples to the data buffer prior to sorting it
+  std::move(cleaned_data.begin(), cleaned_data.end(), std::back_inserter(_data));
+
+  std::sort(_data.begin(), _data.end(), MeasTimeComparator_t());
+
+  std::vector<Chunk_t> chunks;
+  std::optional<Time> latest_lane_time;
+  if (not _lanes.empty())
+  {
+    latest_lane_time = releaseLanes(output, time, frontier, chunks, discarded_data, late_data);
+  }
+
+  // advance our internal buffer time to the last output element (if we later receive anything with an earlier
+  // measurement time stamp (e.g. new sensor)) we have to discard it because we otherwise would forward an
+  // out-of-sequence measurement with respect to the data we already returned
+  if (not output.empty())
+  {
+    _buffer_time = output.back().meas_time;
+  }
+  if (latest_lane_time)
+  {
+    _buffer_time = std::max(_buffer_time, *latest_lane_time);
+  }
+  if (speculative)
+  {
+    for (const TimeData_t &element : output)
     {
-//      std::cout << "found output sample better fitting next for " << element.id << " at: " << element.meas_time << std::endl;
-      // there won't be any other sample fitting to the current ref, since indices have been sorted
-      break;
+      _released_times.push_back(element.meas_time);
     }
+    _released_times.erase(
+        _released_times.begin(),
+        std::lower_bound(_released_times.begin(), _released_times.end(), _buffer_time - _params.speculative.max_retraction));
+  }
 
-    // compare entry is created at first access
-    MatchMapEntry &compare = matching_map[element.id];
-    double current_diff_double = std::chrono::duration<double>(current_diff).count();
-    if (current_diff_double < compare.tau)
+  return { _buffer_time, std::move(output), std::move(discarded_data), {}, std::move(missing_members),
+           std::move(batch_starts), {}, std::move(chunks), std::move(corrections), std::move(missing_samples),
+           {}, std::move(late_data) };
+}
+
+template <class Data, class SourceId>
+std::optional<Time> MinimalLatencyBuffer<Data, SourceId>::releaseLanes(const std::vector<TimeData_t>& output, Time time,
+                                                                       Time frontier, std::vector<Chunk_t>& chunks,
+                                                                       std::vector<TimeData_t>& discarded_data,
+                                                                       std::vector<TimeData_t>& late_data)
+{
+  std::optional<Time> latest_lane_time;
+  for (auto& [id, lane] : _lanes)
+  {
+    const auto first_valid = std::lower_bound(lane.meas_times.begin(), lane.meas_times.end(), _buffer_time);
+    const auto num_discarded = std::distance(lane.meas_times.begin(), first_valid);
+    const auto release_end = std::find_if(first_valid, lane.meas_times.end(),
+                                          [&](const Time meas_time) { return meas_time > time or meas_time >= frontier; });
+    const auto num_released = std::distance(lane.meas_times.begin(), release_end);
+
+    const bool route_late = sourceParams(id).late_routing == LateRouting::LATE;
+    if (route_late or _params.discard_policy != DiscardPolicy::DROP)
+    {
+      for (std::ptrdiff_t i = 0; i < num_discarded; ++i)
+      {
+        TimeData_t element(id, lane.meas_times[i], lane.receipt_times[i], lane.meas_times[i], lane.receipt_times[i],
+                           std::move(lane.data[i]));
+        if (route_late)
+        {
+          late_data.push_back(std::move(element));
+        }
+        else
+        {
+          discard(std::move(element), discarded_data);
+        }
+      }
+    }
+
+    // split the released samples at the samples of the other sources
+    std::size_t position{ 0 };
+    for (std::ptrdiff_t i = num_discarded; i < num_released; ++i)
+    {
+      const Time meas_time = lane.meas_times[i];
+      const std::size_t previous_position = position;
+      while (position < output.size() and output[position].meas_time <= meas_time)
+      {
+        ++position;
+      }
+      if (i == num_discarded or position != previous_position)
+      {
+        chunks.push_back(Chunk_t{ .id = id, .position = position });
+      }
+      chunks.back().meas_times.push_back(meas_time);
+      chunks.back().receipt_times.push_back(lane.receipt_times[i]);
+      chunks.back().data.push_back(std::move(lane.data[i]));
+    }
+    if (num_released > num_discarded)
+    {
+      latest_lane_time = std::max(latest_lane_time.value_or(Time::min()), lane.meas_times[num_released - 1]);
+    }
+
+    lane.meas_times.erase(lane.meas_times.begin(), lane.meas_times.begin() + num_released);
+    lane.receipt_times.erase(lane.receipt_times.begin(), lane.receipt_times.begin() + num_released);
+    lane.data.erase(lane.data.begin(), lane.data.begin() + num_released);
+  }
+
+  // chunks of different sources in front of the same output sample are ordered by their first sample
+  std::stable_sort(chunks.begin(), chunks.end(), [](const Chunk_t& first, const Chunk_t& second) {
+    return first.position < second.position or
+           (first.position == second.position and first.meas_times.front() < second.meas_times.front());
+  });
+  return latest_lane_time;
+}
+
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::BatchResult
+MinimalLatencyBuffer<Data, SourceId>::runBatching(const IndexList& ready_for_output_ids, Time time)
+{
+  BatchResult result;
+  std::size_t window_begin{0};
+  while (window_begin < ready_for_output_ids.size())
+  {
+    const auto batch_start_time = _data.at(ready_for_output_ids[window_begin]).meas_time;
+    std::size_t window_end{window_begin + 1};
+    while (window_end < ready_for_output_ids.size() and
+           _data.at(ready_for_output_ids[window_end]).meas_time - batch_start_time < _params.batch.max_delta)
+    {
+      ++window_end;
+    }
+
+    // placeholders are located after all ready samples, i.e., solely the last window may still be extended
+    if (window_end == ready_for_output_ids.size())
+    {
+      // check whether it is worth waiting for the next input to form a batch
+      bool found_placeholder = false;
+      const auto offset_iter = _data.begin() + ready_for_output_ids.back();
+      for (auto iter = offset_iter; iter != _data.end(); ++iter)
+      {
+        if (not iter->is_placeholder())
+        {
+          continue;
+        }
+
+        if (iter->earliest_estimated_meas_time - batch_start_time < _params.batch.max_delta and
+            iter->latest_receipt_time > time)
+        {
+          found_placeholder = true;
+          break;
+        }
+      }
+
+      if (found_placeholder)
+      {
+        // prevent output of the open window
+        break;
+      }
+    }
+
+    result.batch_starts.push_back(result.output_inds.size());
+    result.output_inds.insert(result.output_inds.end(), ready_for_output_ids.begin() + window_begin,
+                              ready_for_output_ids.begin() + window_end);
+    window_begin = window_end;
+  }
+  return result;
+}
+
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::BatchResult
+MinimalLatencyBuffer<Data, SourceId>::runGridBatching(const IndexList& ready_for_output_ids, Time frontier)
+{
+  BatchResult result;
+  std::optional<std::int64_t> current_cycle;
+  for (const std::size_t idx : ready_for_output_ids)
+  {
+    const std::int64_t cycle = _params.grid.cycle(_data.at(idx).meas_time);
+    if (_params.grid.cycleEnd(cycle) > frontier)
+    {
+      // samples of the current cycle may still be received (the ready samples are sorted, later cycles are open too)
+      break;
+    }
+    if (cycle != current_cycle)
+    {
+      result.batch_starts.push_back(result.output_inds.size());
+      current_cycle = cycle;
+    }
+    result.output_inds.push_back(idx);
+  }
+  return result;
+}
+
+template <class Data, class SourceId>
+std::optional<Duration> MinimalLatencyBuffer<Data, SourceId>::partialDeadline(const MatchGroup_t& group) const
+{
+  return group.partial_deadline ? group.partial_deadline : _params.match.partial_deadline;
+}
+
+template <class Data, class SourceId>
+std::optional<Duration> MinimalLatencyBuffer<Data, SourceId>::maxTau(const MatchGroup_t& group) const
+{
+  return group.max_tau ? group.max_tau : _params.match.max_tau;
+}
+
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::MatchResult
+MinimalLatencyBuffer<Data, SourceId>::runMatching(IndexList ready_for_output_ids, const MatchGroup_t& group, Time time)
+{
+//  std::cout << "running matching" << std::endl;
+
+  MatchResult result;
+  IndexList &tuple_inds = result.tuple_inds;
+  IndexList &delete_inds = result.delete_inds;
+  const std::optional<Duration> partial_deadline = partialDeadline(group);
+
+  // sort output inds to omit full for loops
+  std::sort(ready_for_output_ids.begin(), ready_for_output_ids.end());
+
+  if (_params.match.assignment_window > 0)
+  {
+    // the assignment requires the reference period to bound the candidates of each reference
+    auto est_it = _source_infos->find(group.reference_stream);
+    if (est_it != _source_infos->end() and est_it->second.isInitialized())
+    {
+      return runAssignment(ready_for_output_ids, group, est_it->second.period());
+    }
+  }
+
+  // every complete tuple is emitted, the scan for the next tuple resumes where the previous one ended
+  std::size_t begin_pos{0};
+  std::size_t ref_search_pos{0};
+  while (true)
+  {
+    //////////////////////////////////////////////////
+    // find reference frame (oldest in buffer which may be outputted)
+    //////////////////////////////////////////////////
+    const auto ref_it = std::find_if(ready_for_output_ids.begin() + ref_search_pos, ready_for_output_ids.end(),
+                                     [this, &group](const std::size_t idx) { return _data.at(idx).id == group.reference_stream; });
+    if (ref_it == ready_for_output_ids.end())
+    {
+//      std::cout << "no valid ref found" << std::endl;
+      break;
+    }
+    const std::size_t ref_pos = std::distance(ready_for_output_ids.begin(), ref_it);
+
+    const MatchStatus status = matchReference(ready_for_output_ids, ref_pos, begin_pos, group);
+    // with a partial release, incomplete tuples are released immediately and waiting is limited by the deadline
+    const bool release_partial =
+        status != MatchStatus::TUPLE and partial_deadline and
+        (status == MatchStatus::INCOMPLETE or _data.at(*ref_it).meas_time + *partial_deadline <= time);
+    if (status == MatchStatus::WAIT and not release_partial)
+    {
+//      std::cout << "better to wait" << std::endl;
+      break;
+    }
+    if (status == MatchStatus::INCOMPLETE and not release_partial)
+    {
+      // current reference sample must be deleted, as there is no tuple possible (not even anticipated)
+      // other entries will be deleted automatically, as soon as another tuple is successfully created
+      delete_inds.push_back(*ref_it);
+      ref_search_pos = ref_pos + 1;
+      continue;
+    }
+
+    // output the tuple ordered by the measurement time, i.e., the buffer time is given by its latest sample
+    const std::size_t tuple_begin = tuple_inds.size();
+    _matching_state.appendIndices(tuple_inds);
+    std::sort(tuple_inds.begin() + tuple_begin, tuple_inds.end());
+    const Time tuple_meas_time = _data.at(tuple_inds.back()).meas_time;
+    if (release_partial)
+    {
+      for (const SourceId &id : group.sources)
+      {
+        if (not _matching_state.isMatched(id))
+        {
+          result.missing_members.push_back({ .ref_position = *ref_it, .id = id });
+        }
+      }
+    }
+
+    // remaining samples up to the latest sample of the tuple can not be outputted anymore
+    // (references prior to the current one have already been deleted)
+    while (begin_pos < ready_for_output_ids.size() and _data.at(ready_for_output_ids[begin_pos]).meas_time <= tuple_meas_time)
+    {
+      const std::size_t idx = ready_for_output_ids[begin_pos];
+      const bool deleted_ref = begin_pos < ref_pos and _data.at(idx).id == group.reference_stream;
+      if (not deleted_ref and not std::binary_search(tuple_inds.begin() + tuple_begin, tuple_inds.end(), idx))
+      {
+        delete_inds.push_back(idx);
+      }
+      ++begin_pos;
+    }
+    ref_search_pos = begin_pos;
+  }
+
+//  std::cout << "output tuples: " << tuple_inds.size() << std::endl;
+  return result;
+}
+
+template <class Data, class SourceId>
+MatchStatus MinimalLatencyBuffer<Data, SourceId>::matchReference(const IndexList& ready_for_output_ids,
+                                                                 std::size_t ref_pos,
+                                                                 std::size_t begin_pos,
+                                                                 const MatchGroup_t& group)
+{
+  const std::size_t ref_idx = ready_for_output_ids[ref_pos];
+  const Time oldest_ref_meas_time = _data.at(ref_idx).meas_time;
+  const std::optional<Duration> max_tau = maxTau(group);
+
+  bool found_next_ref{false};
+  Time next_ref_meas_time{ std::chrono::seconds(0) };
+  for (std::size_t pos{ref_pos + 1}; pos < ready_for_output_ids.size(); ++pos)
+  {
+    const TimeData_t &element = _data.at(ready_for_output_ids[pos]);
+    if (element.id == group.reference_stream)
+    {
+//      std::cout << "found valid next" << std::endl;
+      found_next_ref = true;
+      next_ref_meas_time = element.meas_time;
+      break;
+    }
+  }
+
+  if (not found_next_ref)
+  {
+    auto est_it = _source_infos->find(group.reference_stream);
+    if (est_it != _source_infos->end())
+    {
+      next_ref_meas_time = oldest_ref_meas_time + est_it->second.period();
+    }
+  }
+
+//  std::cout << "times: " << oldest_ref_meas_time << " | " << next_ref_meas_time << std::endl;
+//  std::cout << "avail outputs: " << ready_for_output_ids.size() << std::endl;
+//  std::cout << "avail data: " << _data.size() << std::endl;
+
+  // assumption: no overlapping data within single stream (interval/meas_time)
+  // then using the earliest_meas_time is sufficient when considering placeholders
+
+  //////////////////////////////////////////////////
+  // check for fitting matches
+  //////////////////////////////////////////////////
+  _matching_state.clear();
+  MatchMapEntry &ref_el = _matching_state[group.reference_stream];
+  ref_el.idx = ref_idx;
+  ref_el.tau = 0;
+  // remember the highest index used in _data
+  // later on it is sufficient to start there, since _data is sorted
+  std::size_t latest_data_idx{ref_idx};
+  for (std::size_t out_idx{begin_pos}; out_idx < ready_for_output_ids.size(); ++out_idx)
+  {
+    const std::size_t idx = ready_for_output_ids[out_idx];
+    const TimeData_t &element = _data.at(idx);
+    latest_data_idx = idx;
+
+    if (element.id == group.reference_stream or not group.contains(element.id))
+    {
+      // omit taking a newer reference, as only the oldest may be considered
+      continue;
+    }
+
+    auto current_diff = std::chrono::abs(element.meas_time - oldest_ref_meas_time);
+    auto next_diff = std::chrono::abs(element.meas_time - next_ref_meas_time);
+
+    // check if it fits better to the next reference sample
+    if (next_diff < current_diff)
+    {
+//      std::cout << "found output sample better fitting next for " << element.id << " at: " << element.meas_time << std::endl;
+      // there won't be any other sample fitting to the current ref, since indices have been sorted
+      break;
+    }
+    if (max_tau and current_diff > *max_tau)
+    {
+      if (element.meas_time < oldest_ref_meas_time)
+      {
+        continue;
+      }
+      // all further samples exceed the tolerance as well
+      break;
+    }
+
+    // compare entry is created at first access
+    MatchMapEntry &compare = _matching_state[element.id];
+    double current_diff_double = std::chrono::duration<double>(current_diff).count();
+    if (current_diff_double < compare.tau)
     {
 //      std::cout << "taking newer sample for id: " << element.id << " at: " << element.meas_time << std::endl;
       compare.idx = idx;
       compare.tau = current_diff_double;
     }
+  }
+  // IMPORTANT: do not return here if not every source has a valid sample!!
+  // if not enough sample are received, but no better sample is anticipated data must be deleted
+  // by deleting the current reference, everything else is automatically deleted with the next iteration
+
+
+  // all elements coming after latest_data_idx are not currently available for output -> no diff between placeholder and actual data samples
+  // waiting would be required anyway
+  bool found_better_sample {false};
+  for (std::size_t idx{latest_data_idx+1}; idx < _data.size(); ++idx)
+  {
+    const TimeData_t &element = _data.at(idx);
+    if (element.id == group.reference_stream or not group.contains(element.id))
+    {
+      // omit taking a newer reference, as only the oldest may be considered
+      continue;
+    }
+
+    auto current_diff = std::chrono::abs(element.meas_time - oldest_ref_meas_time);
+    auto next_diff = std::chrono::abs(element.meas_time - next_ref_meas_time);
+
+    if (next_diff < current_diff)
+    {
+//      std::cout << "found waiting sample better fitting next" << std::endl;
+      // there won't be any other sample fitting to the current ref, since indices have been sorted
+      break;
+    }
+    if (max_tau and current_diff > *max_tau)
+    {
+      // samples exceeding the tolerance are not worth waiting for
+      break;
+    }
+
+    // creating new entries is explicitly indented here
+    MatchMapEntry &compare = _matching_state[element.id];
+    double current_diff_double = std::chrono::duration<double>(current_diff).count();
+    if (current_diff_double < compare.tau)
+    {
+//      std::cout << "found better fitting waiting sample for this for " << element.id << " at: " << element.meas_time << std::endl;
+      found_better_sample = true;
+      break;
+    }
+  }
+
+  // IMPORTANT: check if tuple possible before waiting if 'found_better_sample'
+  if (_matching_state.size() != group.size())
+  {
+//    std::cout << "tuple impossible; ref sample must be deleted at: " << oldest_ref_meas_time << std::endl;
+    return MatchStatus::INCOMPLETE;
+  }
+
+  if (found_better_sample)
+  {
+    return MatchStatus::WAIT;
+  }
+  return MatchStatus::TUPLE;
+}
+
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::MatchResult
+MinimalLatencyBuffer<Data, SourceId>::runAssignment(const IndexList& ready_for_output_ids,
+                                                    const MatchGroup_t& group,
+                                                    const Duration ref_period)
+{
+  MatchResult result;
+  IndexList &tuple_inds = result.tuple_inds;
+  IndexList &delete_inds = result.delete_inds;
+  const std::optional<Duration> max_tau = maxTau(group);
+
+  // no sample of the group older than the frontier is anticipated anymore
+  Time frontier = Time::max();
+  for (std::size_t idx{ready_for_output_ids.back() + 1}; idx < _data.size(); ++idx)
+  {
+    if (group.contains(_data.at(idx).id))
+    {
+      frontier = _data.at(idx).meas_time;
+      break;
+    }
+  }
+
+  struct Candidate
+  {
+    std::size_t idx;
+    double tau;
+  };
+
+  // a tuple of the k-th reference with the given candidate per source, linked to its preceding tuple
+  struct Assignment
+  {
+    std::size_t ref;
+    std::vector<std::size_t> choice;
+    std::size_t first_idx;  ///< earliest sample of the tuple within _data
+    std::size_t last_idx;   ///< latest sample of the tuple within _data
+    std::size_t num_tuples;
+    double tau;
+    std::optional<std::size_t> prev;
+  };
+
+  const std::size_t num_sources = group.sources.size();
+  std::size_t begin_pos{0};
+  while (begin_pos < ready_for_output_ids.size())
+  {
+    IndexList ref_inds;
+    for (std::size_t pos{begin_pos}; pos < ready_for_output_ids.size() and ref_inds.size() < _params.match.assignment_window; ++pos)
+    {
+      if (_data.at(ready_for_output_ids[pos]).id == group.reference_stream)
+      {
+        ref_inds.push_back(ready_for_output_ids[pos]);
+      }
+    }
+    if (ref_inds.empty())
+    {
+      break;
+    }
+
+    // candidates of every reference: per source, the closest samples prior to and after the reference
+    std::vector<std::vector<std::vector<Candidate>>> candidates(ref_inds.size(), std::vector<std::vector<Candidate>>(num_sources));
+    for (std::size_t k{0}; k < ref_inds.size(); ++k)
+    {
+      const Time ref_meas_time = _data.at(ref_inds[k]).meas_time;
+      std::vector<std::optional<Candidate>> before(num_sources);
+      std::vector<std::optional<Candidate>> after(num_sources);
+      for (std::size_t pos{begin_pos}; pos < ready_for_output_ids.size(); ++pos)
+      {
+        const std::size_t idx = ready_for_output_ids[pos];
+        const TimeData_t &element = _data.at(idx);
+        const auto source_it = std::find(group.sources.begin(), group.sources.end(), element.id);
+        const Duration diff = element.meas_time - ref_meas_time;
+        if (source_it == group.sources.end() or std::chrono::abs(diff) >= ref_period or
+            (max_tau and std::chrono::abs(diff) > *max_tau))
+        {
+          continue;
+        }
+
+        const std::size_t source = std::distance(group.sources.begin(), source_it);
+        const Candidate candidate{ .idx = idx, .tau = std::chrono::duration<double>(std::chrono::abs(diff)).count() };
+        if (diff <= Duration(0))
+        {
+          before[source] = candidate;
+        }
+        else if (not after[source])
+        {
+          after[source] = candidate;
+        }
+      }
+      for (std::size_t source{0}; source < num_sources; ++source)
+      {
+        for (const auto &candidate : { before[source], after[source] })
+        {
+          if (candidate)
+          {
+            candidates[k][source].push_back(*candidate);
+          }
+        }
+      }
+    }
+
+    // dynamic programming over the references: the best chain of tuples ending with each assignment, all samples of a
+    // tuple must succeed the latest sample of its preceding tuple (across all sources) to keep the output in sequence.
+    // Each reference has up to 2^(number of sources) assignments, which are linked to all preceding assignments.
+    auto better = [](std::size_t num_tuples, double tau, const Assignment &other) {
+      return num_tuples > other.num_tuples or (num_tuples == other.num_tuples and tau < other.tau);
+    };
+    std::vector<Assignment> assignments;
+    for (std::size_t k{0}; k < ref_inds.size(); ++k)
+    {
+      const std::size_t num_prev = assignments.size();
+      if (std::any_of(candidates[k].begin(), candidates[k].end(), [](const auto &cands) { return cands.empty(); }))
+      {
+        continue;
+      }
+
+      std::vector<std::size_t> choice(num_sources, 0);
+      bool remaining_choices{true};
+      while (remaining_choices)
+      {
+        double tau{0};
+        std::size_t first_idx{ref_inds[k]};
+        std::size_t last_idx{ref_inds[k]};
+        for (std::size_t source{0}; source < num_sources; ++source)
+        {
+          const Candidate &candidate = candidates[k][source][choice[source]];
+          tau += candidate.tau;
+          first_idx = std::min(first_idx, candidate.idx);
+          last_idx = std::max(last_idx, candidate.idx);
+        }
+
+        Assignment assignment{ .ref = k, .choice = choice, .first_idx = first_idx, .last_idx = last_idx,
+                               .num_tuples = 1, .tau = tau, .prev = std::nullopt };
+        for (std::size_t prev{0}; prev < num_prev; ++prev)
+        {
+          const Assignment &previous = assignments[prev];
+          const bool in_sequence = first_idx > previous.last_idx;
+          if (in_sequence and better(previous.num_tuples + 1, previous.tau + tau, assignment))
+          {
+            assignment.num_tuples = previous.num_tuples + 1;
+            assignment.tau = previous.tau + tau;
+            assignment.prev = prev;
+          }
+        }
+        assignments.push_back(std::move(assignment));
+
+        // next combination of candidates (mixed radix counter)
+        remaining_choices = false;
+        for (std::size_t source{0}; source < num_sources; ++source)
+        {
+          if (++choice[source] < candidates[k][source].size())
+          {
+            remaining_choices = true;
+            break;
+          }
+          choice[source] = 0;
+        }
+      }
+    }
+
+    // collect the best chain of tuples
+    std::vector<bool> assigned_refs(ref_inds.size(), false);
+    std::vector<const Assignment*> chain;
+    std::optional<std::size_t> best;
+    for (std::size_t idx{0}; idx < assignments.size(); ++idx)
+    {
+      if (not best or better(assignments[idx].num_tuples, assignments[idx].tau, assignments[*best]))
+      {
+        best = idx;
+      }
+    }
+    for (std::optional<std::size_t> idx = best; idx; idx = assignments[*idx].prev)
+    {
+      chain.insert(chain.begin(), &assignments[*idx]);
+      assigned_refs[assignments[*idx].ref] = true;
+    }
+
+    // only tuples of references whose candidates are final are released, the others are reconsidered later on
+    // (either no further candidate can be received or there already is a candidate after the reference per source)
+    auto closed = [&](std::size_t k) {
+      return _data.at(ref_inds[k]).meas_time + ref_period <= frontier or
+             std::all_of(candidates[k].begin(), candidates[k].end(), [&](const auto &cands) {
+               return not cands.empty() and _data.at(cands.back().idx).meas_time > _data.at(ref_inds[k]).meas_time;
+             });
+    };
+    const std::size_t tuple_begin = tuple_inds.size();
+    for (const Assignment *assignment : chain)
+    {
+      if (not closed(assignment->ref))
+      {
+        break;
+      }
+      const std::size_t first = tuple_inds.size();
+      tuple_inds.push_back(ref_inds[assignment->ref]);
+      for (std::size_t source{0}; source < num_sources; ++source)
+      {
+        tuple_inds.push_back(candidates[assignment->ref][source][assignment->choice[source]].idx);
+      }
+      std::sort(tuple_inds.begin() + first, tuple_inds.end());
+    }
+
+    // remaining samples up to the latest released sample and unassigned closed references can not be outputted
+    IndexList released(tuple_inds.begin() + tuple_begin, tuple_inds.end());
+    std::sort(released.begin(), released.end());
+    // without any released sample, no sample has been passed
+    const Time released_meas_time = released.empty() ? Time::min() : _data.at(released.back()).meas_time;
+    std::size_t num_closed{0};
+    for (std::size_t k{0}; k < ref_inds.size() and closed(k); ++k)
+    {
+      ++num_closed;
+    }
+
+    std::size_t next_begin_pos{begin_pos};
+    for (std::size_t pos{begin_pos}; pos < ready_for_output_ids.size(); ++pos)
+    {
+      const std::size_t idx = ready_for_output_ids[pos];
+      const auto ref_it = std::find(ref_inds.begin(), ref_inds.begin() + num_closed, idx);
+      const bool dropped_ref = ref_it != ref_inds.begin() + num_closed and not assigned_refs[std::distance(ref_inds.begin(), ref_it)];
+      const bool passed = not released.empty() and _data.at(idx).meas_time <= released_meas_time;
+      if (not passed and not dropped_ref)
+      {
+        continue;
+      }
+      if (not std::binary_search(released.begin(), released.end(), idx))
+      {
+        delete_inds.push_back(idx);
+      }
+      next_begin_pos = pos + 1;
+    }
+
+    // continue with the next window only if all references of the current one have been processed
+    if (num_closed < ref_inds.size() or next_begin_pos == begin_pos)
+    {
+      break;
+    }
+    begin_pos = next_begin_pos;
+  }
+
+  return result;
+}
+
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::PopReturn_t MinimalLatencyBuffer<Data, SourceId>::popGroups(Time time)
+{
+  const std::vector<MatchGroup_t> &groups = _params.match.groups;
+
+  // (group, index within _data) of all output samples in the order of the output
+  std::vector<std::pair<std::size_t, std::size_t>> group_outputs;
+  std::vector<MissingMember_t> missing_members;
+  for (std::size_t group_idx{0}; group_idx < groups.size(); ++group_idx)
+  {
+    const MatchGroup_t &group = groups[group_idx];
+    Time &group_buffer_time = _group_buffer_times[group_idx];
+
+    // newly created placeholders of passed samples may prevent the output of later samples, hence, they have to be
+    // inserted prior to the evaluation
+    IndexList ready_inds;
+    bool created_placeholders{true};
+    while (created_placeholders)
+    {
+      std::tie(ready_inds, created_placeholders) = groupReadyIndices(group, group_buffer_time, time);
+    }
+    if (ready_inds.empty())
+    {
+      continue;
+    }
+
+    const MatchResult match_result = runMatching(ready_inds, group, time);
+    // the group neither outputs nor deletes samples on its own, it solely advances its buffer time
+    const std::size_t group_begin = group_outputs.size();
+    for (const std::size_t idx : match_result.tuple_inds)
+    {
+      group_outputs.emplace_back(group_idx, idx);
+      group_buffer_time = std::max(group_buffer_time, _data.at(idx).meas_time);
+    }
+    for (const MissingMember_t &missing : match_result.missing_members)
+    {
+      const auto ref_it = std::find_if(group_outputs.begin() + group_begin, group_outputs.end(),
+                                       [&missing](const auto &group_output) { return group_output.second == missing.ref_position; });
+      missing_members.push_back({ .ref_position = static_cast<std::size_t>(std::distance(group_outputs.begin(), ref_it)),
+                                  .id = missing.id });
+    }
+    for (const std::size_t idx : match_result.delete_inds)
+    {
+      group_buffer_time = std::max(group_buffer_time, _data.at(idx).meas_time);
+    }
+  }
+
+  // a sample is still required as long as any of the groups it takes part in has not passed it yet
+  auto still_required = [this, &groups](const TimeData_t &element) {
+    for (std::size_t group_idx{0}; group_idx < groups.size(); ++group_idx)
+    {
+      if (groups[group_idx].contains(element.id) and element.meas_time > _group_buffer_times[group_idx])
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  PopReturn_t result{};
+  std::vector<bool> was_output(_data.size(), false);
+  for (std::size_t out_idx{0}; out_idx < group_outputs.size(); ++out_idx)
+  {
+    const auto [group_idx, idx] = group_outputs[out_idx];
+    TimeData_t &element = _data.at(idx);
+    if (not was_output[idx] and _params.discard_control.enabled)
+    {
+      updateDiscardControl(element.id, false);
+    }
+
+    const bool last_output = std::none_of(group_outputs.begin() + out_idx + 1, group_outputs.end(),
+                                          [idx](const auto &group_output) { return group_output.second == idx; });
+    if (last_output and not still_required(element))
+    {
+      result.data.push_back(std::move(element));
+    }
+    else if constexpr (std::is_copy_constructible_v<TimeData_t>)
+    {
+      // the sample remains queued for the other groups, but must not be discarded by them later on
+      result.data.push_back(element);
+      _group_released[element.id].push_back(element.meas_time);
+    }
     else
     {
-//      std::cout << "considered sample is not better: " << element.id << " at: " << element.meas_time << std::endl;
-//      std::cout << "cur_diff: " << current_diff << std::endl;
-//      std::cout << "cur_tau: " << current_diff_double << std::endl;
-//      std::cout << "tau: " << compare.tau << std::endl;
+      // overlapping groups are rejected by the constructor for non-copyable data
+      throw std::logic_error("samples of sources within several match groups require copyable data");
+    }
+    result.match_groups.push_back(group_idx);
+    was_output[idx] = true;
+  }
+  result.missing_members = std::move(missing_members);
+
+  IndexList delete_inds;
+  for (std::size_t idx{0}; idx < _data.size(); ++idx)
+  {
+    TimeData_t &element = _data.at(idx);
+    if (element.is_placeholder() or still_required(element))
+    {
+      continue;
+    }
+    delete_inds.push_back(idx);
+    bool released = was_output[idx];
+    auto released_it = _group_released.find(element.id);
+    if (released_it != _group_released.end())
+    {
+      auto time_it = std::find(released_it->second.begin(), released_it->second.end(), element.meas_time);
+      if (time_it != released_it->second.end())
+      {
+        released = true;
+        released_it->second.erase(time_it);
+      }
+    }
+    if (released)
+    {
+      continue;
+    }
+
+    // only samples which were waited for, but arrived after the expiration of their placeholder are misses
+    if (_params.discard_control.enabled and element.receipt_time > element.latest_receipt_time)
+    {
+      updateDiscardControl(element.id, true);
+    }
+    discard(std::move(element), result.discarded_data);
+  }
+  remove_indices(_data, delete_inds.begin(), delete_inds.end());
+
+  // the buffer time is given by the group lagging behind the most
+  _buffer_time = *std::min_element(_group_buffer_times.begin(), _group_buffer_times.end());
+  result.buffer_time = _buffer_time;
+  return result;
+}
+
+template <class Data, class SourceId>
+MinimalLatencyBuffer<Data, SourceId>::PopReturn_t MinimalLatencyBuffer<Data, SourceId>::popAsOf(Time time)
+{
+  const SourceId &reference_stream = _params.asof.reference_stream;
+
+  PopReturn_t result{};
+  IndexList delete_inds;
+  std::vector<TimeData_t> new_placeholders;
+  for (std::size_t i = 0; i < _data.size(); ++i)
+  {
+    TimeData_t& element = _data.at(i);
+    const bool is_reference = element.id == reference_stream;
+    if (is_reference and element.meas_time >= _buffer_time)
+    {
+      if (element.is_placeholder())
+      {
+        Time deadline = element.receipt_time;
+        if (_params.joint_latency.enabled)
+        {
+          deadline += jointDeadlineOffset(element);
+        }
+        if (deadline >= time)
+        {
+          break;
+        }
+      }
+      else if (element.meas_time > time)
+      {
+        break;
+      }
+    }
+    else if (not element.is_placeholder() and element.meas_time > time)
+    {
+      break;
+    }
+
+    std::vector<TimeData_t> placeholders = create_placeholders(element, _buffer_time);
+    if (is_reference and not placeholders.empty())
+    {
+      time = std::min(time, placeholders.back().meas_time);
+    }
+    std::move(placeholders.begin(), placeholders.end(), std::back_inserter(new_placeholders));
+
+    // placeholders of the other sources are never waited for
+    if (element.is_placeholder())
+    {
+      continue;
+    }
+    delete_inds.push_back(i);
+
+    if (not is_reference)
+    {
+      // samples received after the release of later references are still the latest value for upcoming references
+      auto snapshot_it = std::find_if(_asof_snapshots.begin(), _asof_snapshots.end(),
+                                      [&element](const auto &snapshot) { return snapshot->id == element.id; });
+      if (snapshot_it == _asof_snapshots.end())
+      {
+        _asof_snapshots.push_back(std::make_shared<const TimeData_t>(std::move(element)));
+      }
+      else if ((*snapshot_it)->meas_time <= element.meas_time)
+      {
+        *snapshot_it = std::make_shared<const TimeData_t>(std::move(element));
+      }
+      else
+      {
+        discard(std::move(element), result.discarded_data);
+      }
+    }
+    else if (element.meas_time < _buffer_time)
+    {
+      discard(std::move(element), result.discarded_data);
+    }
+    else
+    {
+      result.asof_snapshots.emplace_back(_asof_snapshots.begin(), _asof_snapshots.end());
+      result.data.push_back(std::move(element));
+    }
+  }
+
+  remove_indices(_data, delete_inds.begin(), delete_inds.end());
+  std::move(new_placeholders.begin(), new_placeholders.end(), std::back_inserter(_data));
+  std::sort(_data.begin(), _data.end(), MeasTimeComparator_t());
 
-    }
+  if (not result.data.empty())
+  {
+    _buffer_time = result.data.back().meas_time;
   }
-  // IMPORTANT: do not return here if not every source has a valid sample!!
-  // if not enough sample are received, but no better sample is anticipated data must be deleted
-  // by deleting the current reference, everything else is automatically deleted with the next iteration
-
+  result.buffer_time = _buffer_time;
+  return result;
+}
 
-  // all elements coming after latest_data_idx are not currently available for output -> no diff between placeholder and actual data samples
-  // waiting would be required anyway
-  bool found_better_sample {false};
-  for (std::size_t idx{latest_data_idx+1}; idx < _data.size(); ++idx)
+template <class Data, class SourceId>
+std::pair<typename MinimalLatencyBuffer<Data, SourceId>::IndexList, bool>
+MinimalLatencyBuffer<Data, SourceId>::groupReadyIndices(const MatchGroup_t& group, Time group_buffer_time, Time time)
+{
+  IndexList ready_inds;
+  std::vector<TimeData_t> new_placeholders;
+  for (std::size_t i = 0; i < _data.size(); ++i)
   {
-    const TimeData_t &element = _data.at(idx);
-    if (element.id == _params.match.reference_stream)
+    TimeData_t& element = _data.at(i);
+    if (not group.contains(element.id))
     {
-      // omit taking a newer reference, as only the oldest may be considered
       continue;
     }
 
-    auto current_diff = std::chrono::abs(element.meas_time - oldest_ref_meas_time);
-    auto next_diff = std::chrono::abs(element.meas_time - next_ref_meas_time);
-
-    if (next_diff < current_diff)
-    {
-//      std::cout << "found waiting sample better fitting next" << std::endl;
-      // there won't be any other sample fitting to the current ref, since indices have been sorted
-      break;
-//      continue;
-    }
-
-    // creating new entries is explicitly indented here
-    MatchMapEntry &compare = matching_map[element.id];
-    double current_diff_double = std::chrono::duration<double>(current_diff).count();
-    if (current_diff_double < compare.tau)
+    if (element.meas_time > group_buffer_time)
     {
-//      std::cout << "found better fitting waiting sample for this for " << element.id << " at: " << element.meas_time << std::endl;
-      found_better_sample = true;
-      break;
+      if (element.is_placeholder())
+      {
+        Time deadline = element.receipt_time;
+        if (_params.joint_latency.enabled)
+        {
+          deadline += jointDeadlineOffset(element);
+        }
+        if (const std::optional<Duration> partial_deadline = partialDeadline(group))
+        {
+          deadline = std::min(deadline, element.meas_time + *partial_deadline);
+        }
+        if (deadline >= time)
+        {
+          break;
+        }
+      }
+      else if (element.meas_time > time)
+      {
+        break;
+      }
+      else
+      {
+        ready_inds.push_back(i);
+      }
     }
-  }
 
-  // IMPORTANT: check if tuple possible before waiting if 'found_better_sample'
-  if (matching_map.size() != _source_infos.size())
-  {
-    // current reference sample must be deleted, as there is no tuple possible (not even anticipated)
-    // other entries will be deleted automatically, as soon as another tuple is successfully created
-    delete_inds.push_back(ref_idx);
-//    std::cout << "tuple impossible; ref sample must be deleted at: " << oldest_ref_meas_time << std::endl;
-    return {tuple_inds, delete_inds};
+    std::vector<TimeData_t> placeholders = create_placeholders(element, group_buffer_time);
+    std::move(placeholders.begin(), placeholders.end(), std::back_inserter(new_placeholders));
   }
 
-  if (found_better_sample)
+  if (new_placeholders.empty())
   {
-//    std::cout << "better to wait" << std::endl;
-    return {tuple_inds, delete_inds};
+    return { ready_inds, false };
   }
-
-  tuple_inds.reserve(matching_map.size());
-  std::transform(matching_map.begin(), matching_map.end(), std::back_inserter(tuple_inds), [] (const auto map_entry) -> std::size_t {return map_entry.second.idx;});
-
-//  std::cout << "output tuple: " << tuple_inds.size() << " | " << matching_map.size() << std::endl;
-  return {tuple_inds, delete_inds};
+  std::move(new_placeholders.begin(), new_placeholders.end(), std::back_inserter(_data));
+  std::sort(_data.begin(), _data.end(), MeasTimeComparator_t());
+  return { {}, true };
 }
 
 template <class Data, class SourceId>
 [[nodiscard]] std::size_t MinimalLatencyBuffer<Data, SourceId>::getNumberOfQueuedElements() const
 {
-  return std::count_if(
+  std::size_t num_elements = std::count_if(
       _data.begin(), _data.end(), [](TimeData_t const& time_data) { return not time_data.is_placeholder(); });
+  for (const auto& [id, lane] : _lanes)
+  {
+    num_elements += lane.size();
+  }
+  for (const auto& [id, stage] : _reorder_stages)
+  {
+    num_elements += stage.size();
+  }
+  return num_elements;
 }
 
 template <class Data, class SourceId>
@@ -616,12 +2271,114 @@ template <class Data, class SourceId>
 template <class Data, class SourceId>
 [[nodiscard]] Time MinimalLatencyBuffer<Data, SourceId>::getEstimatedBufferTime() const
 {
-  if (_data.empty())
+  Time estimated_buffer_time = _data.empty() ? Time::max() : _data.front().meas_time;
+  for (const auto& [id, lane] : _lanes)
+  {
+    if (not lane.empty())
+    {
+      estimated_buffer_time = std::min(estimated_buffer_time, lane.meas_times.front());
+    }
+  }
+  for (const auto& [id, stage] : _reorder_stages)
+  {
+    if (not stage.empty())
+    {
+      estimated_buffer_time = std::min(estimated_buffer_time, stage.front().meas_time);
+    }
+  }
+  for (const auto& [id, source_assemblies] : _assemblies)
+  {
+    if (not source_assemblies.empty())
+    {
+      estimated_buffer_time = std::min(estimated_buffer_time, source_assemblies.begin()->first);
+    }
+  }
+
+  return estimated_buffer_time == Time::max() ? _buffer_time : estimated_buffer_time;
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] Time MinimalLatencyBuffer<Data, SourceId>::getWatermark() const
+{
+  return _watermark;
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::updateWatermark()
+{
+  Time watermark = std::max(_buffer_time, getEstimatedBufferTime());
+  if (_params.mode == BufferMode::SINGLE and _params.speculative.enabled)
+  {
+    // the speculative release corrects late samples within the retraction window
+    watermark = _buffer_time - _params.speculative.max_retraction;
+  }
+  _watermark = std::max(_watermark, watermark);
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::dropStale(PopReturn_t& result, Time time)
+{
+  const auto is_stale = [&](SourceId id, Time meas_time) {
+    const std::optional<Duration>& max_age = sourceParams(id).max_age_at_release;
+    return max_age and time - meas_time > *max_age;
+  };
+  const auto drop = [&](TimeData_t&& element) {
+    ++_num_stale_samples[element.id];
+    if (sourceParams(element.id).report_stale)
+    {
+      result.stale_data.push_back(std::move(element));
+    }
+  };
+
+  // number of kept samples in front of each position within the released data
+  std::vector<std::size_t> kept_positions(result.data.size() + 1);
+  std::vector<TimeData_t> kept;
+  kept.reserve(result.data.size());
+  for (std::size_t i = 0; i < result.data.size(); ++i)
+  {
+    kept_positions[i] = kept.size();
+    TimeData_t& element = result.data[i];
+    if (is_stale(element.id, element.meas_time))
+    {
+      drop(std::move(element));
+    }
+    else
+    {
+      kept.push_back(std::move(element));
+    }
+  }
+  kept_positions.back() = kept.size();
+
+  if (kept.size() != result.data.size())
   {
-    return _buffer_time;
+    // batches without any remaining sample are removed
+    for (std::size_t& batch_start : result.batch_starts)
+    {
+      batch_start = kept_positions[batch_start];
+    }
+    result.batch_starts.erase(std::unique(result.batch_starts.begin(), result.batch_starts.end()),
+                              result.batch_starts.end());
+    std::erase_if(result.batch_starts, [&kept](const std::size_t batch_start) { return batch_start >= kept.size(); });
+    result.data = std::move(kept);
   }
 
-  return _data.front().meas_time;
+  for (Chunk_t& chunk : result.chunks)
+  {
+    chunk.position = kept_positions[chunk.position];
+    // the samples of a chunk are sorted, i.e., the stale samples are located at its front
+    const auto fresh_it = std::find_if(chunk.meas_times.begin(), chunk.meas_times.end(),
+                                       [&](const Time meas_time) { return not is_stale(chunk.id, meas_time); });
+    const auto num_stale = std::distance(chunk.meas_times.begin(), fresh_it);
+    for (std::ptrdiff_t i = 0; i < num_stale; ++i)
+    {
+      drop(TimeData_t(chunk.id, chunk.meas_times[i], chunk.receipt_times[i], chunk.meas_times[i],
+                      chunk.receipt_times[i], std::move(chunk.data[i])));
+    }
+    chunk.meas_times.erase(chunk.meas_times.begin(), fresh_it);
+    chunk.receipt_times.erase(chunk.receipt_times.begin(), chunk.receipt_times.begin() + num_stale);
+    chunk.data.erase(chunk.data.begin(), chunk.data.begin() + num_stale);
+  }
+  std::erase_if(result.chunks, [](const Chunk_t& chunk) { return chunk.empty(); });
 }
 
 template <class Data, class SourceId>
@@ -638,6 +2395,27 @@ template <class Data, class SourceId>
 
     min_receipt_time = std::min(min_receipt_time, element.receipt_time);
   }
+  for (const auto& [id, lane] : _lanes)
+  {
+    for (const Time receipt_time : lane.receipt_times)
+    {
+      min_receipt_time = std::min(min_receipt_time, receipt_time);
+    }
+  }
+  for (const auto& [id, source_assemblies] : _assemblies)
+  {
+    for (const auto& [meas_time, assembly] : source_assemblies)
+    {
+      min_receipt_time = std::min(min_receipt_time, assembly.first_receipt_time);
+    }
+  }
+  for (const auto& [id, stage] : _reorder_stages)
+  {
+    for (const ReorderedSample& sample : stage)
+    {
+      min_receipt_time = std::min(min_receipt_time, sample.receipt_time);
+    }
+  }
 
   return min_receipt_time;
 }
@@ -645,8 +2423,8 @@ template <class Data, class SourceId>
 template <class Data, class SourceId>
 [[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::getEstimatedLatency(SourceId id) const
 {
-  auto it = _source_infos.find(id);
-  if (it != _source_infos.end())
+  auto it = _source_infos->find(id);
+  if (it != _source_infos->end())
   {
     return it->second.latency();
   }
@@ -656,8 +2434,8 @@ template <class Data, class SourceId>
 template <class Data, class SourceId>
 [[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::getEstimatedLatencyStddev(SourceId id) const
 {
-  auto it = _source_infos.find(id);
-  if (it != _source_infos.end())
+  auto it = _source_infos->find(id);
+  if (it != _source_infos->end())
   {
     return it->second.latency_stddev();
   }
@@ -667,8 +2445,8 @@ template <class Data, class SourceId>
 template <class Data, class SourceId>
 [[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::getEstimatedLatencyQuantile(SourceId id, double quantile) const
 {
-  auto it = _source_infos.find(id);
-  if (it != _source_infos.end())
+  auto it = _source_infos->find(id);
+  if (it != _source_infos->end())
   {
     return it->second.latency_quantile(quantile);
   }
@@ -678,8 +2456,8 @@ template <class Data, class SourceId>
 template <class Data, class SourceId>
 [[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::getEstimatedPeriod(SourceId id) const
 {
-  auto it = _source_infos.find(id);
-  if (it != _source_infos.end())
+  auto it = _source_infos->find(id);
+  if (it != _source_infos->end())
   {
     return it->second.period();
   }
@@ -689,8 +2467,8 @@ template <class Data, class SourceId>
 template <class Data, class SourceId>
 [[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::getEstimatedPeriodStddev(SourceId id) const
 {
-  auto it = _source_infos.find(id);
-  if (it != _source_infos.end())
+  auto it = _source_infos->find(id);
+  if (it != _source_infos->end())
   {
     return it->second.period_stddev();
   }
@@ -701,32 +2479,298 @@ template <class Data, class SourceId>
 [[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::getEstimatedPeriodQuantile(SourceId id,
                                                                                                   double quantile) const
 {
-  auto it = _source_infos.find(id);
-  if (it != _source_infos.end())
+  auto it = _source_infos->find(id);
+  if (it != _source_infos->end())
   {
     return it->second.period_quantile(quantile);
   }
   return Duration(0);
 }
 
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::setSourceParams(SourceId id, SourceParams source_params)
+{
+  // invalid overrides leave the buffer untouched
+  validateSourceParams(source_params);
+  if (source_params.best_effort)
+  {
+    // pending placeholders must not hold back the release any longer
+    std::erase_if(_data, [id](const TimeData_t& sample) { return sample.id == id and sample.is_placeholder(); });
+    _lane_placeholders.erase(id);
+  }
+  _params.sources[id] = source_params;
+  // the discard control restarts from the new overrides
+  _controlled_wait_quantiles.erase(id);
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::validateSourceParams(const SourceParams& source_params) const
+{
+  if (source_params.chunked and _params.mode != BufferMode::SINGLE)
+  {
+    throw std::invalid_argument("chunked sources are solely supported in the SINGLE mode");
+  }
+  // the placeholders are sized on the estimation of the undelayed reception
+  if (_external_estimation and (source_params.reorder_window or source_params.assembly_timeout))
+  {
+    throw std::invalid_argument("delaying source stages are not supported with an external estimation");
+  }
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::clearSourceParams(SourceId id)
+{
+  _params.sources.erase(id);
+  _controlled_wait_quantiles.erase(id);
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] SourceParams MinimalLatencyBuffer<Data, SourceId>::getSourceParams(SourceId id) const
+{
+  return sourceParams(id);
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::setAggregator(SourceId id, Aggregator aggregator)
+{
+  _aggregators[id] = std::move(aggregator);
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::reportMissingSample(const TimeData_t& placeholder,
+                                                               std::vector<MissingSample_t>& missing_samples)
+{
+  if (not _params.report_missing_samples)
+  {
+    return;
+  }
+  // expired placeholders are kept until the next sample of their source is received
+  auto [reported_it, inserted] = _reported_missing.try_emplace(placeholder.id, placeholder.meas_time);
+  if (not inserted)
+  {
+    if (reported_it->second >= placeholder.meas_time)
+    {
+      return;
+    }
+    reported_it->second = placeholder.meas_time;
+  }
+  missing_samples.push_back({ placeholder.id, placeholder.meas_time, placeholder.latest_receipt_time });
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::setAssembler(SourceId id, Aggregator assembler)
+{
+  _assemblers[id] = std::move(assembler);
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::decimate(SourceId id, Time meas_time)
+{
+  auto sample_it = std::find_if(_data.begin(), _data.end(), [&id, &meas_time](const TimeData_t &sample) {
+    return sample.id == id and sample.meas_time == meas_time and not sample.is_placeholder();
+  });
+  if (sample_it == _data.end())
+  {
+    return;
+  }
+
+  const DecimationParams &decimation = sourceParams(id).decimation;
+  DecimationState &state = _decimation_states[id];
+  bool keep{ true };
+  if (decimation.policy == DecimationPolicy::EVERY_NTH)
+  {
+    keep = state.counter % std::max<std::size_t>(decimation.factor, 1) == 0;
+  }
+  else if (decimation.policy == DecimationPolicy::LATEST_PER_INTERVAL and decimation.interval > Duration(0))
+  {
+    // the sample is the latest of its interval if the next sample is expected within a later interval
+    auto est_it = _source_infos->find(id);
+    if (est_it != _source_infos->end() and est_it->second.isInitialized())
+    {
+      const Time next_meas_time = meas_time + est_it->second.period();
+      keep = next_meas_time.time_since_epoch() / decimation.interval !=
+             meas_time.time_since_epoch() / decimation.interval;
+    }
+  }
+  ++state.counter;
+
+  auto aggregator_it = _aggregators.find(id);
+  if (not keep)
+  {
+    // the placeholder of the next sample has already been created, hence, the sample can simply be dropped
+    if (aggregator_it != _aggregators.end())
+    {
+      if (state.aggregate)
+      {
+        aggregator_it->second(*state.aggregate, std::move(*sample_it->data));
+      }
+      else
+      {
+        state.aggregate = std::move(sample_it->data);
+      }
+    }
+    _data.erase(sample_it);
+    return;
+  }
+
+  if (state.aggregate and aggregator_it != _aggregators.end())
+  {
+    aggregator_it->second(*state.aggregate, std::move(*sample_it->data));
+    sample_it->data = std::move(state.aggregate);
+  }
+  state.aggregate.reset();
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] const SourceParams& MinimalLatencyBuffer<Data, SourceId>::sourceParams(SourceId id) const
+{
+  static const SourceParams no_overrides{};
+
+  auto it = _params.sources.find(id);
+  if (it != _params.sources.end())
+  {
+    return it->second;
+  }
+  return no_overrides;
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] double MinimalLatencyBuffer<Data, SourceId>::getEffectiveWaitQuantile(SourceId id) const
+{
+  if (_params.discard_control.enabled)
+  {
+    auto it = _controlled_wait_quantiles.find(id);
+    if (it != _controlled_wait_quantiles.end())
+    {
+      return it->second;
+    }
+  }
+  return sourceParams(id).wait_confidence_quantile.value_or(_params.wait_confidence_quantile);
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] std::size_t MinimalLatencyBuffer<Data, SourceId>::getNumberOfStaleSamples(SourceId id) const
+{
+  const auto it = _num_stale_samples.find(id);
+  return it == _num_stale_samples.end() ? 0 : it->second;
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::setDiscardCallback(DiscardCallback callback)
+{
+  _discard_callback = std::move(callback);
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] std::size_t MinimalLatencyBuffer<Data, SourceId>::getNumberOfDiscardedSamples(SourceId id) const
+{
+  const auto it = _num_discarded_samples.find(id);
+  return it == _num_discarded_samples.end() ? 0 : it->second;
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::discard(TimeData_t&& element, std::vector<TimeData_t>& discarded_data)
+{
+  // without any callback, the samples are reported instead of being dropped silently
+  if (_params.discard_policy == DiscardPolicy::COLLECT or
+      (_params.discard_policy == DiscardPolicy::CALLBACK and not _discard_callback))
+  {
+    discarded_data.push_back(std::move(element));
+  }
+  else if (_params.discard_policy == DiscardPolicy::COUNT)
+  {
+    ++_num_discarded_samples[element.id];
+  }
+  else if (_params.discard_policy == DiscardPolicy::CALLBACK)
+  {
+    _discard_callback(std::move(element));
+  }
+}
+
+template <class Data, class SourceId>
+void MinimalLatencyBuffer<Data, SourceId>::updateDiscardControl(SourceId id, bool discarded)
+{
+  const DiscardControlParams &control = _params.discard_control;
+
+  // the configured quantile is used as starting point for the adaption
+  auto [it, inserted] = _controlled_wait_quantiles.try_emplace(id, getEffectiveWaitQuantile(id));
+
+  // stochastic approximation within the log domain of the miss probability: each discard reduces the miss
+  // probability by gain * (1 - target), each output increases it by gain * target
+  // --> stationary if the observed discard rate equals the target rate
+  const double miss_probability = std::max(1 - it->second, std::numeric_limits<double>::epsilon());
+  const double error = control.target_discard_rate - (discarded ? 1.0 : 0.0);
+  const double adapted_quantile = 1 - miss_probability * std::exp(control.gain * error);
+
+  it->second = std::clamp(adapted_quantile, control.min_quantile, control.max_quantile);
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] Duration MinimalLatencyBuffer<Data, SourceId>::jointDeadlineOffset(const TimeData_t& placeholder) const
+{
+  auto est_it = _source_infos->find(placeholder.id);
+  if (est_it == _source_infos->end() or not est_it->second.isInitialized() or est_it->second.latency_stddev().count() == 0)
+  {
+    return Duration(0);
+  }
+
+  const auto conditioning = _joint_latency.condition(placeholder.id, placeholder.meas_time);
+  if (not conditioning)
+  {
+    return Duration(0);
+  }
+
+  // the placeholder expires at mean + k * stddev, while the conditioned distribution is given by
+  // N(mean + stddev * mean_shift, (stddev * stddev_factor)^2)
+  const double k = boost::math::quantile(boost::math::normal_distribution(0.0, 1.0),
+                                         1 - (1 - getEffectiveWaitQuantile(placeholder.id)) / 2);
+  const double stddev = static_cast<double>(est_it->second.latency_stddev().count());
+  const double offset = stddev * (conditioning->mean_shift + (conditioning->stddev_factor - 1) * k);
+
+  const Duration max_abs_wait_jitter = sourceParams(placeholder.id).max_abs_wait_jitter.value_or(_params.max_abs_wait_jitter);
+  return std::clamp(Duration(static_cast<Duration::rep>(offset)), -max_abs_wait_jitter, max_abs_wait_jitter);
+}
+
 template <class Data, class SourceId>
 void MinimalLatencyBuffer<Data, SourceId>::reset()
 {
   _data.clear();
   _buffer_time = Time{ std::chrono::seconds(0) };
   _current_time = Time{ std::chrono::seconds(0) };
-  _source_infos.clear();
+  if (not _external_estimation)
+  {
+    _source_infos->clear();
+  }
+  _controlled_wait_quantiles.clear();
+  _joint_latency.reset();
+  std::fill(_group_buffer_times.begin(), _group_buffer_times.end(), _buffer_time);
+  _group_released.clear();
+  _asof_snapshots.clear();
+  _decimation_states.clear();
+  _lanes.clear();
+  _lane_placeholders.clear();
+  _assemblies.clear();
+  _dropped_assemblies.clear();
+  _reorder_stages.clear();
+  _released_times.clear();
+  _reported_missing.clear();
+  _num_stale_samples.clear();
+  _num_discarded_samples.clear();
+  _watermark = Time{ std::chrono::seconds(0) };
 }
 
 template <class Data, class SourceId>
 [[nodiscard]] std::vector<typename MinimalLatencyBuffer<Data, SourceId>::TimeData_t>
-MinimalLatencyBuffer<Data, SourceId>::create_placeholders(TimeData_t& element, std::size_t max_number) const
+MinimalLatencyBuffer<Data, SourceId>::create_placeholders(TimeData_t& element,
+                                                          const Time buffer_time,
+                                                          std::size_t max_number) const
 {
   // new placeholder elements are only inserted into the queue if the estimator is already properly initialized
   // --> first few measurements of a new sensor might be discarded
+  // best effort sources are never waited for
   std::vector<TimeData_t> out;
-  if (not _source_infos.contains(element.id) or not _source_infos.at(element.id).isInitialized() or
-      element.created_placeholder)
+  if (not _source_infos->contains(element.id) or not _source_infos->at(element.id).isInitialized() or
+      element.created_placeholder or sourceParams(element.id).best_effort)
   {
     return out;
   }
@@ -738,7 +2782,7 @@ MinimalLatencyBuffer<Data, SourceId>::create_placeholders(TimeData_t& element, s
     Time const earliest_expected_meas_time = placeholder.earliest_estimated_meas_time;
     out.emplace_back(std::move(placeholder));
 
-    if (earliest_expected_meas_time > _buffer_time)
+    if (earliest_expected_meas_time > buffer_time)
     {
       out.back().created_placeholder = false;
       break;
@@ -755,15 +2799,28 @@ MinimalLatencyBuffer<Data, SourceId>::createPlaceholder(const SourceId id,
 {
   // new placeholder elements are only inserted into the queue if the estimator is already properly initialized
   // --> first few measurements of a new sensor might be discarded
-  const Estimator &estimator = _source_infos.at(id);
+  const Estimator &estimator = _source_infos->at(id);
   if (not estimator.isInitialized())
   {
     throw std::runtime_error("creating placeholder failed, base sample is not initialized");
   }
 
+  // per-source overrides take precedence over the global parametrization
+  const SourceParams &source_params = sourceParams(id);
+  const double wait_confidence_quantile = getEffectiveWaitQuantile(id);
+  const Duration max_abs_wait_jitter = source_params.max_abs_wait_jitter.value_or(_params.max_abs_wait_jitter);
+  const Duration max_total_wait_time = source_params.max_total_wait_time.value_or(_params.max_total_wait_time);
+
   Duration period_offset = placeholder_index * estimator.period();
   double const period_variance = std::pow(static_cast<double>(estimator.period_stddev().count()), 2);
-  const double period_stddev_sum = std::sqrt(placeholder_index * period_variance);
+  double period_stddev_sum = std::sqrt(placeholder_index * period_variance);
+  if (estimator.usesClockModel())
+  {
+    // the clock model predicts the time stamp with respect to the estimated time grid of the source, hence, the jitter
+    // of the provided time stamp does not accumulate
+    period_offset = estimator.predicted_meas_time(meas_time, placeholder_index) - meas_time;
+    period_stddev_sum = static_cast<double>(estimator.predicted_meas_time_stddev(meas_time, placeholder_index).count());
+  }
 
   Duration meas_quantile_limited{0};
   // check necessary because of unit-testing where perfect input timing causes zero standard deviation
@@ -781,26 +2838,56 @@ MinimalLatencyBuffer<Data, SourceId>::createPlaceholder(const SourceId id,
     );
   }
 
+  // the latency of the next sample is either predicted based on its expected cost or given by the overall average
+  Duration latency = estimator.latency();
+  Duration latency_stddev = estimator.latency_stddev();
+  const bool uses_cost_model = estimator.usesCostModel();
+  if (uses_cost_model)
+  {
+    latency = estimator.predicted_latency(estimator.expected_cost());
+    latency_stddev = estimator.expected_latency_stddev();
+  }
+
   Duration wait_quantile_limited{0};
+  if (estimator.usesEmpiricalLatency() and not uses_cost_model)
+  {
+    // the empirical latency quantile (with respect to the mean) replaces the gaussian latency part, the combination
+    // with the period jitter is equivalent to the gaussian case below
+    const double wait_quantile_level = 1 - (1 - wait_confidence_quantile) / 2;
+    const double latency_jitter = static_cast<double>(
+        (estimator.latency_quantile(wait_quantile_level) - estimator.latency()).count());
+    double period_jitter{0};
+    if (period_stddev_sum > 0)
+    {
+      period_jitter = boost::math::quantile(boost::math::normal_distribution(0.0, period_stddev_sum), wait_quantile_level);
+    }
+    const double wait_quantile = std::hypot(period_jitter, std::max(latency_jitter, 0.0));
+
+    wait_quantile_limited = std::clamp(
+        Duration(static_cast<Duration::rep>(wait_quantile)),
+        -max_abs_wait_jitter,
+        max_abs_wait_jitter
+    );
+  }
   // check necessary because of unit-testing where perfect input timing causes zero standard deviation
-  if (estimator.latency_stddev().count() > 0 )
+  else if (latency_stddev.count() > 0 )
   {
-    const double wait_stddev = std::hypot(period_stddev_sum, static_cast<double>(estimator.latency_stddev().count()));
+    const double wait_stddev = std::hypot(period_stddev_sum, static_cast<double>(latency_stddev.count()));
     const double wait_quantile = boost::math::quantile(
         boost::math::normal_distribution(0.0, wait_stddev),
-        1 - (1 - _params.wait_confidence_quantile) / 2
+        1 - (1 - wait_confidence_quantile) / 2
     );
 
     wait_quantile_limited = std::clamp(
         Duration(static_cast<Duration::rep>(wait_quantile)),
-        -_params.max_abs_wait_jitter,
-        _params.max_abs_wait_jitter
+        -max_abs_wait_jitter,
+        max_abs_wait_jitter
     );
   }
 
   Time earliest_expected_meas_time = meas_time + period_offset + meas_quantile_limited;
 
-  Time latest_expected_reception_time = meas_time + period_offset + std::min(estimator.latency() + wait_quantile_limited, _params.max_total_wait_time);
+  Time latest_expected_reception_time = meas_time + period_offset + std::min(latency + wait_quantile_limited, max_total_wait_time);
 
   return { .id = id,
            .meas_time = earliest_expected_meas_time,
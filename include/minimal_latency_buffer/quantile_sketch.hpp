@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace minimal_latency_buffer
+{
+
+/**
+ * Bounded memory estimation of arbitrary quantiles based on the latest samples of a stream.
+ *
+ * In contrast to marker based sketches (e.g. P²), the quantile does not need to be known in advance, which allows to
+ * evaluate different (and changing) confidence levels on the same data. Old samples are forgotten once the window is
+ * full, i.e., the sketch follows slow changes of the underlying distribution.
+ *
+ * The window is additionally kept sorted, i.e., adding a sample costs a binary search and a shift within the window,
+ * while evaluating a quantile is a constant time lookup (quantiles are evaluated more often than samples are added).
+ */
+class SlidingWindowQuantileSketch
+{
+public:
+  explicit SlidingWindowQuantileSketch(std::size_t window_size = 256) : _window_size{ std::max<std::size_t>(window_size, 1) }
+  {
+    _samples.reserve(_window_size);
+    _sorted.reserve(_window_size);
+  }
+
+  void add(double sample)
+  {
+    if (_samples.size() < _window_size)
+    {
+      _samples.push_back(sample);
+    }
+    else
+    {
+      // the oldest sample leaves the window
+      _sorted.erase(std::lower_bound(_sorted.begin(), _sorted.end(), _samples[_next_idx]));
+      _samples[_next_idx] = sample;
+    }
+    _sorted.insert(std::upper_bound(_sorted.begin(), _sorted.end(), sample), sample);
+    _next_idx = (_next_idx + 1) % _window_size;
+  }
+
+  /**
+   * @param quantile Requested quantile within [0, 1].
+   * @return Empirical quantile (linearly interpolated between the order statistics) or 0 if the sketch is empty.
+   */
+  [[nodiscard]] double quantile(double quantile) const
+  {
+    if (_sorted.empty())
+    {
+      return 0;
+    }
+
+    const double position = std::clamp(quantile, 0.0, 1.0) * static_cast<double>(_sorted.size() - 1);
+    const auto lower_idx = static_cast<std::size_t>(std::floor(position));
+    const auto upper_idx = std::min(lower_idx + 1, _sorted.size() - 1);
+    const double lower = _sorted[lower_idx];
+    const double upper = _sorted[upper_idx];
+
+    return lower + (position - static_cast<double>(lower_idx)) * (upper - lower);
+  }
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return _samples.size();
+  }
+
+  void clear()
+  {
+    _samples.clear();
+    _sorted.clear();
+    _next_idx = 0;
+  }
+
+private:
+  std::size_t _window_size;
+  std::size_t _next_idx = 0;
+  std::vector<double> _samples;  ///< ring buffer in insertion order
+  std::vector<double> _sorted;   ///< samples of the window in ascending order
+};
+
+}  // namespace minimal_latency_buffer
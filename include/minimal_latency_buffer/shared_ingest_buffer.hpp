@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+#include "minimal_latency_buffer/types.hpp"
+
+namespace minimal_latency_buffer
+{
+
+/**
+ * Single ingest of all sources serving several subscriber views.
+ *
+ * The stream characteristics of every source are estimated once by the ingest. Each view is a MinimalLatencyBuffer
+ * with its own mode and confidences, which solely receives the samples of its subscribed sources, i.e., a view never
+ * waits for any other source. The payload of a sample is shared across all views (read-only).
+ *
+ * Solely the estimation is shared, the per-source stages (decimation and chunked lane) are parametrized within the
+ * parameters of each view and hence remain within the view. A source with such overrides in several views is processed
+ * once per view. Stages delaying the samples (reorder window, multi-part assembly) are rejected by the views, since the
+ * shared estimation is not aware of the delay.
+ *
+ * @tparam Data     Type of the measurement.
+ * @tparam SourceId Type used for identifying different source IDs.
+ */
+template <class Data, class SourceId = std::size_t>
+class SharedIngestBuffer
+{
+public:
+  using Data_t = Data;
+  using SourceId_t = SourceId;
+  using Payload = std::shared_ptr<const Data>;
+
+  using View = MinimalLatencyBuffer<Payload, SourceId>;
+  using Estimator = typename View::Estimator;
+  using EstimatorMap = typename View::EstimatorMap;
+  using PopReturn_t = typename View::PopReturn_t;
+
+  struct ViewParams
+  {
+    // sources delivered by the view
+    std::vector<SourceId> sources{};
+    // mode, confidences and per-source overrides of the view (the estimator parametrization is ignored, reorder windows
+    // and assembly timeouts are rejected)
+    typename View::Params params{};
+  };
+
+  struct Params
+  {
+    // If the receipt time jumps further into the past than this threshold, the ingest and all views are reset
+    Duration reset_threshold = std::chrono::seconds(1);
+    // parametrization of the per-source stream characteristics estimation shared by all views
+    typename Estimator::Params estimator{};
+    std::vector<ViewParams> views{};
+  };
+
+  explicit SharedIngestBuffer(Params params);
+
+  /**
+   * Updates the estimation of the source and forwards the sample to all views subscribing to it.
+   */
+  [[nodiscard]] PushReturn push(SourceId id, Time receipt_time, Time meas_time, Data&& data,
+                                std::optional<double> cost = std::nullopt);
+
+  /**
+   * @param view Index of the view within the parameters.
+   */
+  PopReturn_t pop(std::size_t view, Time time);
+
+  [[nodiscard]] const View& view(std::size_t view) const;
+  [[nodiscard]] std::size_t numViews() const;
+
+  void reset();
+
+protected:
+  /**
+   * Updates the estimator of the source, missed samples are derived from the estimated period (samples within half a
+   * period of their expected measurement time are matched as done for the placeholders).
+   */
+  void updateEstimator(SourceId id, Time receipt_time, Time meas_time, std::optional<double> cost);
+
+  Params _params;
+  std::shared_ptr<EstimatorMap> _estimators = std::make_shared<EstimatorMap>();
+  std::vector<View> _views;
+  std::unordered_map<SourceId, std::vector<std::size_t>> _subscriptions;  ///< views subscribing to each source
+  std::unordered_map<SourceId, Time> _latest_meas_times;
+  Time _current_time = Time{ std::chrono::seconds(0) };
+};
+
+
+//////////////////////////////////////
+/// Definition of member functions ///
+//////////////////////////////////////
+
+template <class Data, class SourceId>
+SharedIngestBuffer<Data, SourceId>::SharedIngestBuffer(Params params) : _params{ std::move(params) }
+{
+  _views.reserve(_params.views.size());
+  for (std::size_t view_idx = 0; view_idx < _params.views.size(); ++view_idx)
+  {
+    const ViewParams& view_params = _params.views[view_idx];
+    _views.emplace_back(view_params.params, _estimators, view_params.sources);
+    for (const SourceId& id : view_params.sources)
+    {
+      _subscriptions[id].push_back(view_idx);
+    }
+  }
+}
+
+template <class Data, class SourceId>
+auto SharedIngestBuffer<Data, SourceId>::push(SourceId id, Time receipt_time, Time meas_time, Data&& data,
+                                              std::optional<double> cost) -> PushReturn
+{
+  if (_current_time - receipt_time > _params.reset_threshold)
+  {
+    reset();
+    return PushReturn::RESET;
+  }
+  _current_time = std::max(_current_time, receipt_time);
+
+  updateEstimator(id, receipt_time, meas_time, cost);
+
+  auto subscription_it = _subscriptions.find(id);
+  if (subscription_it == _subscriptions.end())
+  {
+    return PushReturn::OK;
+  }
+
+  const Payload payload = std::make_shared<const Data>(std::move(data));
+  for (const std::size_t view_idx : subscription_it->second)
+  {
+    if (_views[view_idx].push(id, receipt_time, meas_time, Payload(payload), cost) == PushReturn::RESET)
+    {
+      // views are solely reset together with the ingest
+      reset();
+      return PushReturn::RESET;
+    }
+  }
+  return PushReturn::OK;
+}
+
+template <class Data, class SourceId>
+auto SharedIngestBuffer<Data, SourceId>::pop(std::size_t view, Time time) -> PopReturn_t
+{
+  return _views.at(view).pop(time);
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] auto SharedIngestBuffer<Data, SourceId>::view(std::size_t view) const -> const View&
+{
+  return _views.at(view);
+}
+
+template <class Data, class SourceId>
+[[nodiscard]] std::size_t SharedIngestBuffer<Data, SourceId>::numViews() const
+{
+  return _views.size();
+}
+
+template <class Data, class SourceId>
+void SharedIngestBuffer<Data, SourceId>::reset()
+{
+  _estimators->clear();
+  _latest_meas_times.clear();
+  _current_time = Time{ std::chrono::seconds(0) };
+  for (View& view : _views)
+  {
+    view.reset();
+  }
+}
+
+template <class Data, class SourceId>
+void SharedIngestBuffer<Data, SourceId>::updateEstimator(SourceId id, Time receipt_time, Time meas_time,
+                                                         std::optional<double> cost)
+{
+  auto estimator_it = _estimators->find(id);
+  if (estimator_it == _estimators->end())
+  {
+    _estimators->emplace(id, Estimator{ receipt_time, meas_time, _params.estimator });
+    _latest_meas_times[id] = meas_time;
+    return;
+  }
+
+  Estimator& estimator = estimator_it->second;
+  Time& latest_meas_time = _latest_meas_times[id];
+  try
+  {
+    if (not estimator.isInitialized())
+    {
+      estimator.update(receipt_time, meas_time, 0, cost);
+    }
+    else if (meas_time > latest_meas_time and estimator.period() > Duration(0))
+    {
+      const double num_periods = static_cast<double>((meas_time - latest_meas_time).count()) /
+                                 static_cast<double>(estimator.period().count());
+      const std::size_t num_missed = num_periods > 1.5 ? static_cast<std::size_t>(std::lround(num_periods)) - 1 : 0;
+      estimator.update(receipt_time, meas_time, num_missed, cost);
+    }
+    else
+    {
+      // out of order samples do not provide any information about the period
+      estimator.updateLatencyOnly(receipt_time, meas_time, cost);
+    }
+  }
+  catch (const std::runtime_error&)
+  {
+    // the number of missed samples contradicts the period estimate (e.g., after a jitter spike), the sample is skipped
+    // for the estimation as done by the buffer itself
+  }
+  latest_meas_time = std::max(latest_meas_time, meas_time);
+}
+
+}  // namespace minimal_latency_buffer
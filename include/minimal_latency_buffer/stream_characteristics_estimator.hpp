@@ -2,10 +2,21 @@
 
 #include <iostream>
 #include <chrono>
+#include <optional>
 #include <boost/math/distributions/normal.hpp>
 
+#include "minimal_latency_buffer/clock_model.hpp"
+#include "minimal_latency_buffer/quantile_sketch.hpp"
+
 namespace minimal_latency_buffer
 {
+
+enum class LatencyModel
+{
+  GAUSSIAN,   ///< latency quantiles are evaluated on a gauss distribution (moving average of mean and variance)
+  EMPIRICAL,  ///< latency quantiles are evaluated on a sliding window of the latest latency samples
+};
+
 template <class ClockT = std::chrono::high_resolution_clock, class DurationT = std::chrono::duration<int64_t, std::nano>>
 class StreamCharacteristicsEstimator
 {
@@ -13,21 +24,96 @@ public:
   using Duration = DurationT;
   using Time = std::chrono::time_point<ClockT, DurationT>;
 
+  struct Params
+  {
+    // smoothing factor of the moving averages
+    double alpha = 0.05;
+    // model used for evaluating latency quantiles (mean and variance are estimated in any case)
+    LatencyModel latency_model = LatencyModel::GAUSSIAN;
+    // number of latest latency samples considered by the empirical latency model
+    std::size_t latency_window_size = 256;
+
+    // predict measurement time stamps based on a linear clock model instead of extrapolating the latest time stamp
+    bool use_clock_model = false;
+    // standard deviation of the period drift per period (relative to the period) assumed by the clock model
+    double clock_drift_stddev = 1e-5;
+
+    // detect abrupt changes of latency and period (two-sided CUSUM on the standardized residuals) and temporarily
+    // increase the smoothing factor to re-converge quickly
+    bool change_detection = false;
+    // standardized residual tolerated without accumulating evidence for a change
+    double change_drift = 0.5;
+    // accumulated evidence required to signal a change
+    double change_threshold = 8.0;
+    // smoothing factor applied after a detected change
+    double change_alpha = 0.3;
+    // number of updates the increased smoothing factor is applied
+    std::size_t change_num_updates = 20;
+  };
+
   StreamCharacteristicsEstimator(Time current_time, Time meas_time, double alpha = 0.05);
+  StreamCharacteristicsEstimator(Time current_time, Time meas_time, Params params);
 
   [[nodiscard]] Duration latency() const;
   [[nodiscard]] Duration latency_stddev() const;
   [[nodiscard]] Duration latency_quantile(double quantile) const;
+  /**
+   * @return True if latency quantiles are evaluated empirically (requires enough samples within the window).
+   */
+  [[nodiscard]] bool usesEmpiricalLatency() const;
+
+  /**
+   * @return True if enough samples with a varying cost feature were provided to predict the latency based on the cost.
+   */
+  [[nodiscard]] bool usesCostModel() const;
+  /**
+   * Latency predicted by the linear regression of the latency on the cost feature (e.g., payload size).
+   * @param cost Cost feature of the sample.
+   */
+  [[nodiscard]] Duration predicted_latency(double cost) const;
+  /**
+   * @return Standard deviation of the latency which is not explained by the cost feature.
+   */
+  [[nodiscard]] Duration predicted_latency_stddev() const;
+  /**
+   * @return Standard deviation of the latency predicted for the next sample, whose cost is not known in advance (i.e.,
+   *         the prediction error of the expected cost is added to predicted_latency_stddev()).
+   */
+  [[nodiscard]] Duration expected_latency_stddev() const;
+  /**
+   * @return Cost feature expected for the next sample (the latest provided cost).
+   */
+  [[nodiscard]] double expected_cost() const;
 
   [[nodiscard]] Duration period() const;
   [[nodiscard]] Duration period_stddev() const;
   [[nodiscard]] Duration period_quantile(double quantile) const;
 
+  /**
+   * @return True if the clock model is enabled and initialized.
+   */
+  [[nodiscard]] bool usesClockModel() const;
+  /**
+   * Predicts a future measurement time stamp based on the clock model.
+   * @param meas_time   Measurement time stamp of a sample of this source (usually the latest one).
+   * @param num_periods Number of periods the predicted time stamp is located after the provided one.
+   */
+  [[nodiscard]] Time predicted_meas_time(Time meas_time, std::size_t num_periods) const;
+  [[nodiscard]] Duration predicted_meas_time_stddev(Time meas_time, std::size_t num_periods) const;
 
-  [[nodiscard]] std::size_t getNumUpdates() const;
 
-  void update(Time current_time, Time meas_time, std::size_t num_missing_measurements = 0);
-  void updateLatencyOnly(Time current_time, Time meas_time);
+  [[nodiscard]] std::size_t getNumUpdates() const;
+  /**
+   * @return Number of abrupt changes of latency or period detected so far.
+   */
+  [[nodiscard]] std::size_t getNumDetectedChanges() const;
+
+  /**
+   * @param cost Optional cost feature of the sample (e.g., payload size) the latency is regressed on.
+   */
+  void update(Time current_time, Time meas_time, std::size_t num_missing_measurements = 0,
+              std::optional<double> cost = std::nullopt);
+  void updateLatencyOnly(Time current_time, Time meas_time, std::optional<double> cost = std::nullopt);
 
   [[nodiscard]] bool isInitialized() const;
 
@@ -39,24 +125,79 @@ private:
     double variance = 0;
   };
 
+  // two-sided CUSUM state
+  struct ChangeDetector {
+    double positive_sum = 0;
+    double negative_sum = 0;
+    // remaining number of updates using the increased smoothing factor
+    std::size_t num_boosted_updates = 0;
+  };
+
+  // moving averages for the linear regression of the latency on the cost feature
+  struct CostRegression {
+    std::size_t num_samples = 0;
+    double cost_mean = 0;
+    double latency_mean = 0;
+    double cost_variance = 0;
+    double covariance = 0;
+    // variance of the prediction error
+    double residual_variance = 0;
+    double latest_cost = 0;
+    // variance of the change between consecutive costs, i.e., of the error of the expected cost
+    double cost_change_variance = 0;
+  };
+
   [[nodiscard]] State updateEstimates(const State &state, const double &estimate, bool update_variance = true) const;
+  [[nodiscard]] State updateEstimates(const State &state, const double &estimate, bool update_variance, double alpha) const;
+  /**
+   * Accumulates the standardized residual of the estimate and checks for an abrupt change.
+   * @return True if a change was detected with this estimate.
+   */
+  bool detectChange(ChangeDetector &detector, const State &state, double estimate);
+  /**
+   * @return Smoothing factor to be applied for the next update (consumes a boosted update if applicable).
+   */
+  double adaptionRate(ChangeDetector &detector) const;
   void updatePeriodEstimate(double estimate, std::size_t num_missing_measurements);
   void updateLatencyEstimate(double estimate);
+  void updateCostRegression(double cost, double latency);
+  [[nodiscard]] double predictLatency(double cost) const;
 
   std::size_t _num_updates = 0;
+  std::size_t _num_detected_changes = 0;
   Time _last_meas_time = Time{ Duration(0) };
   Time _current_time = Time{ Duration(0) };
+  Params _params;
   double _alpha;
 
   State _period_state;
   State _latency_state;
+  ChangeDetector _period_detector;
+  ChangeDetector _latency_detector;
+  SlidingWindowQuantileSketch _latency_sketch;
+  LinearClockModel _clock_model;
+  CostRegression _cost_regression;
+
+  // minimal number of latency samples before switching from the gauss distribution to empirical quantiles
+  static constexpr std::size_t MIN_EMPIRICAL_SAMPLES = 10;
+  // minimal number of samples with cost feature before predicting the latency based on the cost
+  static constexpr std::size_t MIN_COST_SAMPLES = 10;
 };
 
 template <class Clock, class Duration>
-StreamCharacteristicsEstimator<Clock, Duration>::StreamCharacteristicsEstimator(Time current_time, Time meas_time, const double alpha) : _last_meas_time{ meas_time }, _current_time{ current_time }, _alpha(alpha)
+StreamCharacteristicsEstimator<Clock, Duration>::StreamCharacteristicsEstimator(Time current_time, Time meas_time, const double alpha) : StreamCharacteristicsEstimator(current_time, meas_time, Params{ .alpha = alpha })
+{
+}
+
+template <class Clock, class Duration>
+StreamCharacteristicsEstimator<Clock, Duration>::StreamCharacteristicsEstimator(Time current_time, Time meas_time, Params params) : _last_meas_time{ meas_time }, _current_time{ current_time }, _params(params), _alpha(params.alpha), _latency_sketch(params.latency_window_size), _clock_model(params.clock_drift_stddev, params.alpha)
 {
     // latency can be directly initialized with the first sample while the remaining parameters required a second one
     _latency_state.mean = static_cast<double>(std::chrono::duration_cast<Duration>(current_time - meas_time).count());
+    if (_params.latency_model == LatencyModel::EMPIRICAL)
+    {
+        _latency_sketch.add(_latency_state.mean);
+    }
 }
 
 template <class Clock, class Duration>
@@ -74,6 +215,11 @@ template <class Clock, class Duration>
 template <class Clock, class Duration>
 [[nodiscard]] Duration StreamCharacteristicsEstimator<Clock, Duration>::latency_quantile(double quantile) const
 {
+    if (usesEmpiricalLatency())
+    {
+      return Duration(static_cast<Duration::rep>(_latency_sketch.quantile(quantile)));
+    }
+
     // should only occur within unit-testing
     if (_latency_state.variance == 0) {
       // if no variance, all quantiles are technically on the mean value
@@ -84,6 +230,46 @@ template <class Clock, class Duration>
     return Duration(static_cast<Duration::rep>(boost::math::quantile(dist, quantile)));
 }
 
+template <class Clock, class Duration>
+[[nodiscard]] bool StreamCharacteristicsEstimator<Clock, Duration>::usesEmpiricalLatency() const
+{
+    return _params.latency_model == LatencyModel::EMPIRICAL and _latency_sketch.size() >= MIN_EMPIRICAL_SAMPLES;
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] bool StreamCharacteristicsEstimator<Clock, Duration>::usesCostModel() const
+{
+    return _cost_regression.num_samples >= MIN_COST_SAMPLES and _cost_regression.cost_variance > 0;
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] Duration StreamCharacteristicsEstimator<Clock, Duration>::predicted_latency(const double cost) const
+{
+    return Duration(static_cast<Duration::rep>(predictLatency(cost)));
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] Duration StreamCharacteristicsEstimator<Clock, Duration>::predicted_latency_stddev() const
+{
+    return Duration(static_cast<Duration::rep>(std::sqrt(_cost_regression.residual_variance)));
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] Duration StreamCharacteristicsEstimator<Clock, Duration>::expected_latency_stddev() const
+{
+    // the error of the expected cost propagates through the regression slope
+    const CostRegression &regression = _cost_regression;
+    const double slope = regression.cost_variance > 0 ? regression.covariance / regression.cost_variance : 0;
+    return Duration(static_cast<Duration::rep>(
+        std::sqrt(regression.residual_variance + slope * slope * regression.cost_change_variance)));
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] double StreamCharacteristicsEstimator<Clock, Duration>::expected_cost() const
+{
+    return _cost_regression.latest_cost;
+}
+
 template <class Clock, class Duration>
 [[nodiscard]] Duration StreamCharacteristicsEstimator<Clock, Duration>::period() const
 {
@@ -109,6 +295,26 @@ template <class Clock, class Duration>
     return Duration(static_cast<Duration::rep>(boost::math::quantile(dist, quantile)));
 }
 
+template <class Clock, class Duration>
+[[nodiscard]] bool StreamCharacteristicsEstimator<Clock, Duration>::usesClockModel() const
+{
+  return _params.use_clock_model and _clock_model.isInitialized();
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] StreamCharacteristicsEstimator<Clock, Duration>::Time StreamCharacteristicsEstimator<Clock, Duration>::predicted_meas_time(const Time meas_time, const std::size_t num_periods) const
+{
+  const auto stamp = std::chrono::duration_cast<Duration>(meas_time.time_since_epoch()).count();
+  return Time{ Duration(static_cast<Duration::rep>(_clock_model.predict(stamp, num_periods))) };
+}
+
+template <class Clock, class Duration>
+[[nodiscard]] Duration StreamCharacteristicsEstimator<Clock, Duration>::predicted_meas_time_stddev(const Time meas_time, const std::size_t num_periods) const
+{
+  const auto stamp = std::chrono::duration_cast<Duration>(meas_time.time_since_epoch()).count();
+  return Duration(static_cast<Duration::rep>(_clock_model.predictionStddev(stamp, num_periods)));
+}
+
 template <class Clock, class Duration>
 std::size_t StreamCharacteristicsEstimator<Clock, Duration>::getNumUpdates() const
 {
@@ -116,15 +322,40 @@ std::size_t StreamCharacteristicsEstimator<Clock, Duration>::getNumUpdates() con
 }
 
 template <class Clock, class Duration>
-void StreamCharacteristicsEstimator<Clock, Duration>::update(const Time current_time, const Time meas_time, const std::size_t num_missing_measurement)
+std::size_t StreamCharacteristicsEstimator<Clock, Duration>::getNumDetectedChanges() const
+{
+  return _num_detected_changes;
+}
+
+template <class Clock, class Duration>
+void StreamCharacteristicsEstimator<Clock, Duration>::update(const Time current_time, const Time meas_time, const std::size_t num_missing_measurement, const std::optional<double> cost)
 {
     // determine new estimates
     auto estimated_latency = static_cast<double>(std::chrono::duration_cast<Duration>(current_time - meas_time).count());
     auto estimated_period = static_cast<double>(std::chrono::duration_cast<Duration>(meas_time - _last_meas_time).count());
 
+    std::size_t num_missing = num_missing_measurement;
+    if (_params.use_clock_model)
+    {
+      const auto stamp = std::chrono::duration_cast<Duration>(meas_time.time_since_epoch()).count();
+      if (_clock_model.isInitialized())
+      {
+        // the clock model determines the number of missing measurements on its own
+        num_missing = _clock_model.update(stamp) - 1;
+      }
+      else
+      {
+        _clock_model.initialize(std::chrono::duration_cast<Duration>(_last_meas_time.time_since_epoch()).count(), stamp);
+      }
+    }
+
     // perform update step (including potential initialization)
-    updatePeriodEstimate(estimated_period, num_missing_measurement);
+    updatePeriodEstimate(estimated_period, num_missing);
     updateLatencyEstimate(estimated_latency);
+    if (cost)
+    {
+      updateCostRegression(cost.value(), estimated_latency);
+    }
 
     _last_meas_time = meas_time;
     _current_time = current_time;
@@ -132,12 +363,16 @@ void StreamCharacteristicsEstimator<Clock, Duration>::update(const Time current_
 }
 
 template <class Clock, class Duration>
-void StreamCharacteristicsEstimator<Clock, Duration>::updateLatencyOnly(const Time current_time, const Time meas_time)
+void StreamCharacteristicsEstimator<Clock, Duration>::updateLatencyOnly(const Time current_time, const Time meas_time, const std::optional<double> cost)
 {
   // determine new estimates
   auto estimated_latency = static_cast<double>(std::chrono::duration_cast<Duration>(current_time - meas_time).count());
 
   updateLatencyEstimate(estimated_latency);
+  if (cost)
+  {
+    updateCostRegression(cost.value(), estimated_latency);
+  }
 
   _last_meas_time = meas_time;
   _current_time = current_time;
@@ -153,15 +388,49 @@ template <class Clock, class Duration>
 
 template <class Clock, class Duration>
 StreamCharacteristicsEstimator<Clock, Duration>::State StreamCharacteristicsEstimator<Clock, Duration>::updateEstimates(const StreamCharacteristicsEstimator::State &state, const double &estimate, bool update_variance) const {
+    return updateEstimates(state, estimate, update_variance, _alpha);
+}
+
+template <class Clock, class Duration>
+StreamCharacteristicsEstimator<Clock, Duration>::State StreamCharacteristicsEstimator<Clock, Duration>::updateEstimates(const StreamCharacteristicsEstimator::State &state, const double &estimate, bool update_variance, const double alpha) const {
     const auto diff = estimate - state.mean;
-    const auto increment = _alpha * diff;
+    const auto increment = alpha * diff;
     const auto mean = state.mean + increment;
 
-    const auto variance = (update_variance) ? (1 - _alpha) * (state.variance + diff * increment) : state.variance;
+    const auto variance = (update_variance) ? (1 - alpha) * (state.variance + diff * increment) : state.variance;
 
     return { mean, variance };
 }
 
+template <class Clock, class Duration>
+bool StreamCharacteristicsEstimator<Clock, Duration>::detectChange(ChangeDetector &detector, const State &state, const double estimate) {
+    // detection is paused while re-converging after a change, and requires a valid variance
+    if (not _params.change_detection or detector.num_boosted_updates > 0 or state.variance <= 0) {
+        return false;
+    }
+
+    const double residual = (estimate - state.mean) / std::sqrt(state.variance);
+    detector.positive_sum = std::max(0.0, detector.positive_sum + residual - _params.change_drift);
+    detector.negative_sum = std::max(0.0, detector.negative_sum - residual - _params.change_drift);
+
+    if (detector.positive_sum < _params.change_threshold and detector.negative_sum < _params.change_threshold) {
+        return false;
+    }
+
+    detector = ChangeDetector{ .num_boosted_updates = _params.change_num_updates };
+    _num_detected_changes++;
+    return true;
+}
+
+template <class Clock, class Duration>
+double StreamCharacteristicsEstimator<Clock, Duration>::adaptionRate(ChangeDetector &detector) const {
+    if (detector.num_boosted_updates == 0) {
+        return _alpha;
+    }
+    detector.num_boosted_updates--;
+    return std::max(_alpha, _params.change_alpha);
+}
+
 template <class Clock, class Duration>
 void StreamCharacteristicsEstimator<Clock, Duration>::updatePeriodEstimate(const double estimate, const std::size_t num_missing_measurements) {
     // Note: in contrast to the latency estimation the period requires three data points (since we need two differences
@@ -197,11 +466,24 @@ void StreamCharacteristicsEstimator<Clock, Duration>::updatePeriodEstimate(const
       return;
     }
 
-    _period_state = updateEstimates(_period_state, corrected_estimate);
+    detectChange(_period_detector, _period_state, corrected_estimate);
+    _period_state = updateEstimates(_period_state, corrected_estimate, true, adaptionRate(_period_detector));
 }
 
 template <class Clock, class Duration>
 void StreamCharacteristicsEstimator<Clock, Duration>::updateLatencyEstimate(const double estimate) {
+    const bool changed = (_num_updates > 0) and detectChange(_latency_detector, _latency_state, estimate);
+
+    if (_params.latency_model == LatencyModel::EMPIRICAL)
+    {
+        // samples prior to the change do not represent the current latency distribution anymore
+        if (changed)
+        {
+            _latency_sketch.clear();
+        }
+        _latency_sketch.add(estimate);
+    }
+
     // initialization
     if (_num_updates == 0) {
         // Note: first latency estimate is already received within the constructor, hence, the variance can already
@@ -217,6 +499,49 @@ void StreamCharacteristicsEstimator<Clock, Duration>::updateLatencyEstimate(cons
         return;
     }
 
-    _latency_state = updateEstimates(_latency_state, estimate);
+    _latency_state = updateEstimates(_latency_state, estimate, true, adaptionRate(_latency_detector));
+}
+
+template <class Clock, class Duration>
+void StreamCharacteristicsEstimator<Clock, Duration>::updateCostRegression(const double cost, const double latency) {
+    CostRegression &regression = _cost_regression;
+    const double cost_change = cost - regression.latest_cost;
+    regression.latest_cost = cost;
+
+    if (regression.num_samples == 0) {
+        regression.cost_mean = cost;
+        regression.latency_mean = latency;
+        regression.num_samples++;
+        return;
+    }
+
+    regression.cost_change_variance = (regression.num_samples == 1)
+                                          ? cost_change * cost_change
+                                          : (1 - _alpha) * regression.cost_change_variance +
+                                                _alpha * cost_change * cost_change;
+
+    // the prediction error is evaluated prior to the update to not underestimate the residual variance
+    const double residual = latency - predictLatency(cost);
+    regression.residual_variance = (regression.num_samples == 1)
+                                       ? residual * residual
+                                       : (1 - _alpha) * regression.residual_variance + _alpha * residual * residual;
+
+    const double cost_diff = cost - regression.cost_mean;
+    const double latency_diff = latency - regression.latency_mean;
+    regression.cost_mean += _alpha * cost_diff;
+    regression.latency_mean += _alpha * latency_diff;
+    regression.cost_variance = (1 - _alpha) * (regression.cost_variance + _alpha * cost_diff * cost_diff);
+    regression.covariance = (1 - _alpha) * (regression.covariance + _alpha * cost_diff * latency_diff);
+    regression.num_samples++;
+}
+
+template <class Clock, class Duration>
+double StreamCharacteristicsEstimator<Clock, Duration>::predictLatency(const double cost) const {
+    const CostRegression &regression = _cost_regression;
+    if (regression.cost_variance <= 0) {
+        return regression.latency_mean;
+    }
+    const double slope = regression.covariance / regression.cost_variance;
+    return regression.latency_mean + slope * (cost - regression.cost_mean);
 }
 }  // namespace min_latency_buffer
@@ -1,5 +1,9 @@
 #pragma once
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <optional>
 #include <unordered_map>
@@ -16,6 +20,8 @@ enum class BufferMode
   SINGLE,  ///< the buffer delivers data with increasing time stamps as soon as possible
   BATCH,   ///< the buffer tries to batch data, this may introduce an additional delay
   MATCH,   ///< the buffer tries to match data, this may introduce an additional delay
+  GRID,    ///< the buffer batches data aligned to a fixed time grid, each cycle is delivered once it is complete
+  ASOF,    ///< the buffer delivers reference samples together with the latest sample of every other source
 };
 
 enum class PushReturn
@@ -24,12 +30,93 @@ enum class PushReturn
   RESET,
 };
 
+/**
+ * Member missing within a partially released tuple (MATCH mode).
+ */
+template <typename SourceId>
+struct MissingMember
+{
+  // position of the reference sample of the partial tuple within the output data
+  std::size_t ref_position{0};
+  SourceId id{};
+};
+
+/**
+ * Expected sample which has not been received until the expiration of its placeholder.
+ */
+template <typename SourceId>
+struct MissingSample
+{
+  SourceId id{};
+  // earliest expected measurement time (with respect to the measurement jitter)
+  Time earliest_meas_time{};
+  // latest expected reception time which passed without receiving the sample
+  Time latest_receipt_time{};
+};
+
+/**
+ * Contiguous samples of a chunked source (see SourceParams::chunked), sorted by their measurement time.
+ */
+template <typename SourceId, typename Data>
+struct Chunk
+{
+  SourceId id{};
+  // position within the output data in front of which the chunk is ordered (the size of the output data if the chunk
+  // follows all of its samples)
+  std::size_t position{0};
+  std::vector<Time> meas_times{};
+  std::vector<Time> receipt_times{};
+  std::vector<Data> data{};
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return meas_times.size();
+  }
+  [[nodiscard]] bool empty() const
+  {
+    return meas_times.empty();
+  }
+};
+
+/**
+ * Late sample released by the speculative release (see SpeculativeParams) instead of being discarded.
+ */
+template <typename Data>
+struct Correction
+{
+  Data sample;
+  // number of already released samples measured after the late sample, i.e., the late sample belongs in front of them
+  std::size_t num_retracted{0};
+};
+
 template <typename Data>
 struct PopReturn
 {
   Time buffer_time;
   std::vector<Data> data;
   std::vector<Data> discarded_data;
+  // MATCH mode with match groups: index of the group each output sample belongs to (same order as data)
+  std::vector<std::size_t> match_groups{};
+  // MATCH mode with partial release: members missing within the released partial tuples
+  std::vector<MissingMember<decltype(Data::id)>> missing_members{};
+  // BATCH/GRID mode: position of the first sample of every released batch within data
+  std::vector<std::size_t> batch_starts{};
+  // ASOF mode: latest samples of the other sources at the measurement time of each reference sample within data (the
+  // samples are shared across all references they are valid for)
+  std::vector<std::vector<std::shared_ptr<const Data>>> asof_snapshots{};
+  // SINGLE mode: released samples of chunked sources, split at the samples of the other sources within data
+  std::vector<Chunk<decltype(Data::id), typename decltype(Data::data)::value_type>> chunks{};
+  // SINGLE mode with speculative release: late samples which would have been sorted in front of previously released
+  // samples (to be applied prior to the data of the same pop)
+  std::vector<Correction<Data>> corrections{};
+  // optional (see report_missing_samples): expected samples whose placeholder expired since the previous pop
+  std::vector<MissingSample<decltype(Data::id)>> missing_samples{};
+  // no sample with an older measurement time will be released by later pops (monotonic, reported by every pop)
+  Time watermark{};
+  // late samples of the sources routed to the late channel (see SourceParams::late_routing)
+  std::vector<Data> late_data{};
+  // samples exceeding the maximal age of their source at the release (see SourceParams::report_stale)
+  std::vector<Data> stale_data{};
 };
 
 template <typename SourceId, typename Data>
@@ -70,12 +157,225 @@ struct BatchParams
   Duration max_delta = std::chrono::milliseconds(10);  ///< the max time delta of a batch
 };
 
+/**
+ * Time grid of the GRID mode, the k-th cycle covers the measurement times [origin + k * period, origin + (k+1) * period).
+ */
+struct GridParams
+{
+  Time origin = Time{ std::chrono::seconds(0) };
+  Duration period = std::chrono::milliseconds(50);
+
+  /**
+   * @return Index of the cycle covering the given measurement time.
+   */
+  [[nodiscard]] std::int64_t cycle(Time meas_time) const
+  {
+    const Duration offset = meas_time - origin;
+    std::int64_t index = offset / period;
+    // round towards negative infinity for measurements prior to the origin
+    if (offset % period < Duration(0))
+    {
+      --index;
+    }
+    return index;
+  }
+
+  /**
+   * @return End (exclusive) of the given cycle.
+   */
+  [[nodiscard]] Time cycleEnd(std::int64_t index) const
+  {
+    return origin + (index + 1) * period;
+  }
+};
+
+/**
+ * Subset of sources whose samples are matched to the samples of a common reference stream.
+ */
+template <typename SourceId>
+struct MatchGroup
+{
+  SourceId reference_stream{};
+  // further sources taking part in the tuples of this group
+  std::vector<SourceId> sources{};
+  // overrides the partial release deadline of the match parameters for this group
+  std::optional<Duration> partial_deadline{};
+  // overrides the tau tolerance of the match parameters for this group
+  std::optional<Duration> max_tau{};
+
+  [[nodiscard]] bool contains(const SourceId& id) const
+  {
+    return id == reference_stream or std::find(sources.begin(), sources.end(), id) != sources.end();
+  }
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return sources.size() + 1;
+  }
+};
+
+/**
+ * As-of join: every reference sample is released as soon as possible, i.e., the buffer solely waits for the reference
+ * stream. The samples of the other sources are not delivered on their own, but kept as snapshot of their latest value.
+ * Note: solely supported by the MinimalLatencyBuffer.
+ */
+template <typename SourceId>
+struct AsOfParams
+{
+  SourceId reference_stream{};
+};
+
+/**
+ * Speculative release for consumers which are able to roll back (e.g., by handling out-of-sequence measurements): the
+ * samples are released as soon as they are received instead of waiting for the placeholders of the other sources.
+ * Late samples are released as corrections, as long as they are not older than max_retraction with respect to the
+ * buffer time (older samples are discarded).
+ * Note: solely supported within the SINGLE mode of the MinimalLatencyBuffer.
+ */
+struct SpeculativeParams
+{
+  bool enabled = false;
+  Duration max_retraction = std::chrono::seconds(1);
+};
+
 template <typename SourceId>
 struct MatchParams
 {
   SourceId reference_stream{};
   // if not estimated by the buffer, the total number of streams must be specified
   std::size_t num_streams{0};
+  // optional independent match groups evaluated over the same data (reference_stream is unused if groups are set)
+  // Note: samples of sources taking part in several groups are copied for all but the last group
+  std::vector<MatchGroup<SourceId>> groups{};
+  // number of reference samples jointly considered by the optimal tuple assignment (0: greedy matching of the oldest
+  // reference), each reference has up to 2^(number of sources) candidate tuples, which are linked to all candidate
+  // tuples of the preceding references, i.e., the effort grows with (window * 2^(number of sources))^2. The assignment
+  // solely releases complete tuples, hence, it can not be combined with a partial release deadline (the buffer throws
+  // std::invalid_argument).
+  std::size_t assignment_window{0};
+  // time after the measurement of a reference sample at which its tuple is released even if members are missing
+  // (unset: incomplete tuples are dropped), placeholders of members do not block the output beyond this deadline
+  std::optional<Duration> partial_deadline{};
+  // maximal acquisition time difference between a member sample and the reference sample (unset: unlimited)
+  std::optional<Duration> max_tau{};
+};
+
+enum class DecimationPolicy
+{
+  NONE,
+  EVERY_NTH,            ///< solely every n-th sample is stored
+  LATEST_PER_INTERVAL,  ///< solely the latest sample within each interval of the measurement time is stored
+};
+
+enum class DiscardPolicy
+{
+  COLLECT,   ///< discarded samples are reported within PopReturn::discarded_data
+  COUNT,     ///< discarded samples are solely counted per source
+  CALLBACK,  ///< discarded samples are handed over to the discard callback (reported like COLLECT if none is set)
+  DROP,      ///< discarded samples are deleted without any further handling
+};
+
+enum class LateRouting
+{
+  DISCARDED,  ///< late samples are reported within PopReturn::discarded_data
+  LATE,       ///< late samples are reported within PopReturn::late_data
+};
+
+/**
+ * Decimation of a source prior to storing its samples within the buffer.
+ *
+ * The stream characteristics are still estimated based on every received sample, i.e., the buffer keeps waiting for
+ * the samples at the full rate of the source.
+ */
+struct DecimationParams
+{
+  DecimationPolicy policy = DecimationPolicy::NONE;
+  // EVERY_NTH: ratio of received to stored samples
+  std::size_t factor{ 1 };
+  // LATEST_PER_INTERVAL: width of the intervals (aligned to the epoch of the clock), the latest sample of an interval
+  // is identified based on the estimated period of the source
+  Duration interval = std::chrono::milliseconds(10);
+};
+
+/**
+ * Per-source overrides for the buffer parameters, unset values fall back to the globally configured parameters.
+ */
+struct SourceParams
+{
+  // overrides the global confidence used for evaluating the wait time distribution
+  std::optional<double> wait_confidence_quantile{};
+  // overrides the global limit of the absolute waiting jitter
+  std::optional<Duration> max_abs_wait_jitter{};
+  // overrides the global limit of the maximal time the buffer waits for a sample of this source
+  std::optional<Duration> max_total_wait_time{};
+  // decimation of the samples of this source (no global counterpart)
+  DecimationParams decimation{};
+  // SINGLE mode: stores the samples of this (high rate) source within a contiguous chunk instead of individual queue
+  // elements, solely the next expected sample is tracked by a placeholder (no global counterpart, the buffer throws
+  // std::invalid_argument for chunked sources in any other mode)
+  bool chunked{ false };
+  // multi-part measurements (see MinimalLatencyBuffer::pushPart()): incomplete measurements are assembled from their
+  // received parts after this timeout (counted from the reception of their first part), otherwise they are dropped as
+  // soon as a later measurement of the source is completed (no global counterpart)
+  std::optional<Duration> assembly_timeout{};
+  // reorders the samples of a source violating the in-order delivery, each sample is held back for this window after
+  // its reception and released in order of the measurement times (the window delay is added to the latency of the
+  // source, i.e., it is considered within the waiting time for the source; no global counterpart)
+  std::optional<Duration> reorder_window{};
+  // the source never holds back the release, i.e., no placeholders are created for its samples and they are solely
+  // merged into the output if received in time (no global counterpart)
+  bool best_effort{ false };
+  // channel reporting the samples of this source received after later samples have already been released (no global
+  // counterpart)
+  LateRouting late_routing{ LateRouting::DISCARDED };
+  // samples older than this age (relative to the time of the pop) are dropped instead of being released, i.e., work on
+  // samples which are no longer useful downstream is shed (no global counterpart)
+  std::optional<Duration> max_age_at_release{};
+  // reports the samples dropped due to their age within PopReturn::stale_data
+  bool report_stale{ false };
+};
+
+/**
+ * Online adaption of the wait confidence quantile of each source towards a targeted discard rate.
+ *
+ * Only samples discarded because they arrived after their placeholder expired are considered as misses, i.e., the
+ * controller reduces the waiting time as far as possible while keeping the rate of these misses at the target.
+ */
+struct DiscardControlParams
+{
+  bool enabled = false;
+  // targeted ratio of samples per source that are discarded due to arriving too late
+  double target_discard_rate = 0.01;
+  // adaption step size (applied within the log domain of the miss probability 1 - quantile)
+  double gain = 0.5;
+  // limits of the adapted wait confidence quantile
+  double min_quantile = 0.5;
+  double max_quantile = 0.9999;
+};
+
+/**
+ * Joint consideration of the latencies of all sources, i.e., latency excursions shared across sources (e.g., caused by
+ * a common network link or host) are used to predict the latency of samples still missing.
+ */
+struct JointLatencyParams
+{
+  bool enabled = false;
+  // maximal measurement time offset of samples of different sources considered to be affected by the same conditions
+  Duration max_time_offset = std::chrono::milliseconds(20);
+  // minimal absolute correlation required to condition a missing sample on a sample of another source
+  double min_correlation = 0.3;
+  // smoothing factor of the correlation estimation
+  double alpha = 0.05;
+};
+
+/**
+ * Result of matching the samples of all sources to a single reference sample.
+ */
+enum class MatchStatus
+{
+  TUPLE,       ///< a complete tuple has been found
+  INCOMPLETE,  ///< no complete tuple is possible, the reference sample has to be deleted
+  WAIT,        ///< a better fitting sample is anticipated
 };
 
 struct MatchMapEntry
@@ -85,8 +385,103 @@ struct MatchMapEntry
   double tau{std::numeric_limits<double>::max()};
 };
 
+/**
+ * Flat matching state holding the best fitting sample per source for the currently evaluated reference.
+ *
+ * Sources are assigned to slots at their first access and keep them across clear(), hence, the state can be reused for
+ * every tuple without any allocation once all sources have been seen.
+ */
 template <typename SourceId>
-using MatchingMap = std::unordered_map<SourceId, MatchMapEntry>;
+class MatchingState
+{
+public:
+  /**
+   * @return Entry of the given source, the entry is marked as used at first access (like std::unordered_map).
+   */
+  MatchMapEntry& operator[](const SourceId& id)
+  {
+    const std::size_t slot = getSlot(id);
+    if (not _used[slot])
+    {
+      _used[slot] = true;
+      ++_num_used;
+    }
+    return _entries[slot];
+  }
+
+  [[nodiscard]] bool contains(const SourceId& id) const
+  {
+    const auto it = std::find(_ids.begin(), _ids.end(), id);
+    return it != _ids.end() and _used[std::distance(_ids.begin(), it)];
+  }
+
+  /**
+   * @return Flag whether an actual sample has been matched for the given source (entries may solely be created by
+   *         anticipated samples).
+   */
+  [[nodiscard]] bool isMatched(const SourceId& id) const
+  {
+    const auto it = std::find(_ids.begin(), _ids.end(), id);
+    if (it == _ids.end())
+    {
+      return false;
+    }
+    const std::size_t slot = std::distance(_ids.begin(), it);
+    return _used[slot] and _entries[slot].tau < std::numeric_limits<double>::max();
+  }
+
+  /**
+   * @return Number of used entries.
+   */
+  [[nodiscard]] std::size_t size() const
+  {
+    return _num_used;
+  }
+
+  /**
+   * Appends the sample indices of all matched entries.
+   */
+  void appendIndices(std::vector<std::size_t>& indices) const
+  {
+    for (std::size_t slot{ 0 }; slot < _entries.size(); ++slot)
+    {
+      if (_used[slot] and _entries[slot].tau < std::numeric_limits<double>::max())
+      {
+        indices.push_back(_entries[slot].idx);
+      }
+    }
+  }
+
+  /**
+   * Marks all entries as unused while keeping the slots of the sources.
+   */
+  void clear()
+  {
+    std::fill(_entries.begin(), _entries.end(), MatchMapEntry{});
+    std::fill(_used.begin(), _used.end(), false);
+    _num_used = 0;
+  }
+
+private:
+  std::size_t getSlot(const SourceId& id)
+  {
+    // the number of matched sources is small, a linear search beats hashing here
+    const auto it = std::find(_ids.begin(), _ids.end(), id);
+    if (it != _ids.end())
+    {
+      return std::distance(_ids.begin(), it);
+    }
+    _ids.push_back(id);
+    _entries.emplace_back();
+    _used.push_back(false);
+    return _ids.size() - 1;
+  }
+
+  std::vector<SourceId> _ids;
+  std::vector<MatchMapEntry> _entries;
+  std::vector<bool> _used;
+  std::size_t _num_used{ 0 };
+};
 
 //////////////////////////////////////
 /// Definition of helper functions ///
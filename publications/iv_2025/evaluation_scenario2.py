@@ -1,17 +1,34 @@
+import copy
 import datetime
 from visualization import create_plots
 from matplotlib import pyplot as plt
 import numpy as np
 import random
 
-from minimal_latency_buffer import Params, Mode, Buffer, FixedLagBuffer, FixedLagBufferParams
+from minimal_latency_buffer import MLParams, Mode, FLParams
 
 from minimal_latency_buffer.evaluation_framework.generators import MeasGenParams
 from minimal_latency_buffer.evaluation_framework.monte_carlo_framework import evaluate_MC, format_timedelta, RunData
+from minimal_latency_buffer.evaluation_framework.analysis import print_tuple_yield
 
 random.seed(7)
 
 
+def transient_metrics(results, start, end):
+    """Discard rate and mean output delay within [start, end) accumulated over all runs."""
+    num_inputs = 0
+    num_discarded = 0
+    delays = []
+    for run_data in results:
+        num_inputs += len([time for time in run_data.inputs if start <= time < end])
+        for pop_time, pop_result in run_data.outputs.items():
+            if not start <= pop_time < end:
+                continue
+            num_discarded += len(pop_result.discarded_data)
+            delays += [(pop_time - element.data.receipt_time).total_seconds() for element in pop_result.data]
+    return num_discarded / max(num_inputs, 1), np.mean(delays) if delays else float('nan')
+
+
 if __name__ == "__main__":
     print("### Monte-Carlo Evaluation for buffer - Two Sensor Scenario ###")
 
@@ -45,16 +62,59 @@ if __name__ == "__main__":
     sensors1 = [sensor_0, sensor_1]
     sensors2 = [sensor_3, sensor_1]
 
-    adaptive_buffer_params = Params()
+    adaptive_buffer_params = MLParams()
     adaptive_buffer_params.mode = Mode.Single
     adaptive_buffer_params.jitter_quantile = 0.99
     adaptive_buffer_params.max_jitter = datetime.timedelta(milliseconds=10000000)
     adaptive_buffer_params.max_wait_duration_quantile = 0.99
     adaptive_buffer_params.max_wait_duration = datetime.timedelta(milliseconds=1000000)
 
-    # fixed_lag_buffer_params = FixedLagBufferParams(lag=datetime.timedelta(milliseconds=100))
-    fixed_lag_buffer_params = FixedLagBufferParams(lag=datetime.timedelta(milliseconds=123.38))
+    # same configuration, but the estimators detect the latency jump and re-converge quickly
+    change_detection_buffer_params = copy.deepcopy(adaptive_buffer_params)
+    change_detection_buffer_params.estimator.change_detection = True
+
+    fixed_lag_buffer_params = FLParams()
+    # fixed_lag_buffer_params.delay_mean = datetime.timedelta(milliseconds=100)
+    fixed_lag_buffer_params.delay_mean = datetime.timedelta(milliseconds=123.38)
     change_step = 25000
+    # duration after the latency jump considered as transient phase
+    transient_duration = datetime.timedelta(seconds=2)
+
+    Time0 = datetime.datetime.fromtimestamp(0, tz=datetime.UTC)
+    transient_start = Time0 + pop_period*change_step
+
+    # tuple yield of the greedy matching and the optimal tuple assignment (MATCH mode, sensor 0 as reference) on the
+    # jittered and partially dropped samples of the initial sensors
+    tuple_yield_results = {}
+    for name, assignment_window in [("greedy", 0), ("assignment", 4)]:
+        match_buffer_params = copy.deepcopy(adaptive_buffer_params)
+        match_buffer_params.mode = Mode.Match
+        match_buffer_params.match.reference_stream = 0
+        match_buffer_params.match.assignment_window = assignment_window
+        tuple_yield_results[name] = evaluate_MC(pop_period=pop_period,
+                                                meas_gen_params=sensors1,
+                                                buffer_params=match_buffer_params,
+                                                skip_verification=True,
+                                                num_iterations_per_run=40000,
+                                                num_runs=10,
+                                                num_warm_up=10000)
+    print_tuple_yield(tuple_yield_results, reference_stream=0)
+
+    # evaluate the transient behavior of the adaptive buffer with and without change detection
+    for name, params in [("fixed smoothing", adaptive_buffer_params), ("change detection", change_detection_buffer_params)]:
+        transient_results = evaluate_MC(pop_period=pop_period,
+                                        meas_gen_params=sensors1,
+                                        modified_meas_gen_params=sensors2,
+                                        change_step=change_step,
+                                        buffer_params=params,
+                                        skip_verification=True,
+                                        num_iterations_per_run=40000,
+                                        num_runs=10,
+                                        num_warm_up=10000)
+        discard_rate, mean_delay = transient_metrics(transient_results, transient_start,
+                                                     transient_start + transient_duration)
+        print(f"Transient ({name}): discard rate {discard_rate*100:.2f} %, mean delay {mean_delay*1000:.2f} ms")
+
     results = evaluate_MC(pop_period=pop_period,
                           meas_gen_params=sensors1,
                           modified_meas_gen_params=sensors2,
@@ -67,7 +127,6 @@ if __name__ == "__main__":
                           num_runs=10,
                           num_warm_up=10000)
 
-    Time0 = datetime.datetime.fromtimestamp(0, tz=datetime.UTC)
     results1 = []
     results2 = []
     for run_data in results:
@@ -1,4 +1,5 @@
-from typing import List
+import numpy as np
+from typing import Dict, List
 from dataclasses import asdict
 
 from minimal_latency_buffer.evaluation_framework.monte_carlo_framework import RunData, format_timedelta
@@ -66,3 +67,50 @@ def print_statistics(data: List[RunData], time_unit='ms'):
             else:
                 print(f"  {key}: {format_timedelta(value)}")
 
+
+def print_comparison(results: Dict[str, List[RunData]], time_unit='ms'):
+    """
+    Compares the discard rate and the buffer delay (pop time - receipt time) of different buffer configurations
+    evaluated on the same inputs.
+    """
+    time_scaling, unit_abbreviation = map_to_time_scaling(time_unit)
+
+    print("\n### Comparison ###")
+    print(f"{'configuration':<20} {'discarded [%]':>14} {'delay mean':>14} {'delay q50':>14} {'delay q99':>14}")
+    for name, data in results.items():
+        num_output = 0
+        num_discarded = 0
+        delays = []
+        for run_data in data:
+            for pop_time, pop_result in run_data.outputs.items():
+                num_discarded += len(pop_result.discarded_data)
+                num_output += len(pop_result.data)
+                delays += [(pop_time - element.data.receipt_time).total_seconds() * time_scaling
+                           for element in pop_result.data]
+
+        discard_rate = num_discarded / max(num_output + num_discarded, 1) * 100
+        if len(delays) == 0:
+            delays = [float('nan')]
+        print(f"{name:<20} {discard_rate:>14.2f} "
+              f"{np.mean(delays):>11.2f} {unit_abbreviation:<2} "
+              f"{np.quantile(delays, 0.5):>11.2f} {unit_abbreviation:<2} "
+              f"{np.quantile(delays, 0.99):>11.2f} {unit_abbreviation:<2}")
+
+
+def print_tuple_yield(results: Dict[str, List[RunData]], reference_stream: int):
+    """
+    Compares the tuple yield (released tuples per received reference sample) of different MATCH mode configurations
+    evaluated on the same inputs.
+    """
+    print("\n### Tuple Yield ###")
+    print(f"{'configuration':<20} {'references':>14} {'tuples':>14} {'yield [%]':>14}")
+    for name, data in results.items():
+        num_references = 0
+        num_tuples = 0
+        for run_data in data:
+            num_references += sum(1 for element in run_data.inputs.values() if element.id == reference_stream)
+            for pop_result in run_data.outputs.values():
+                num_tuples += sum(1 for element in pop_result.data if element.id == reference_stream)
+
+        tuple_yield = num_tuples / max(num_references, 1) * 100
+        print(f"{name:<20} {num_references:>14} {num_tuples:>14} {tuple_yield:>14.2f}")
@@ -12,12 +12,12 @@ from rclpy.serialization import deserialize_message
 from rosidl_runtime_py.utilities import get_message
 from tqdm import tqdm
 
-from minimal_latency_buffer import Buffer, Params, Mode, PushReturn, FixedLagBuffer, FixedLagBufferParams
+from minimal_latency_buffer import MinimalLatencyBuffer, MLParams, Mode, PushReturn, FixedLagBuffer, FLParams, LatencyModel
 
 from minimal_latency_buffer.evaluation_framework.generators import PopGenerator
 from minimal_latency_buffer.evaluation_framework.monte_carlo_framework import Estimates, Input, RunData, print_params
 from minimal_latency_buffer.evaluation_framework.visualization import create_plots
-from minimal_latency_buffer.evaluation_framework.analysis import print_statistics
+from minimal_latency_buffer.evaluation_framework.analysis import print_statistics, print_comparison
 
 def initialize_shortening_LUT(topics_of_interest: Set) -> Dict[str, str]:
     lut = {}
@@ -31,7 +31,7 @@ def initialize_shortening_LUT(topics_of_interest: Set) -> Dict[str, str]:
 
 
 def evaluate_rosbag(pop_period: timedelta,
-                    buffer_params: Params,
+                    buffer_params: MLParams | FLParams,
                     rosbag_path: str,
                     topic_filter: Set[str] = None) -> RunData:
     assert os.path.isdir(rosbag_path), f"ROSbag \'{rosbag_path}\' does not exist!"
@@ -80,14 +80,16 @@ def evaluate_rosbag(pop_period: timedelta,
         print(" - ", topic)
 
     name_shortening_LUT = initialize_shortening_LUT(topics_of_interest)
+    # the buffer requires integral source ids
+    source_id_LUT = {topic: idx for idx, topic in enumerate(sorted(topics_of_interest))}
 
     # setup required classes
     pop_gen = None  # fully initialized once the timestamp of the first message is known
 
-    # toggle here to switch between buffer implementations
-    # buffer = Buffer(buffer_params)
-    buffer = FixedLagBuffer(FixedLagBufferParams(lag=timedelta(milliseconds=180)))
-    # buffer = FixedLagBuffer(FixedLagBufferParams(lag=timedelta(milliseconds=225)))
+    if isinstance(buffer_params, MLParams):
+        buffer = MinimalLatencyBuffer(buffer_params)
+    else:
+        buffer = FixedLagBuffer(buffer_params)
 
     print("\n### Iterating over the rosbag ###")
 
@@ -114,19 +116,20 @@ def evaluate_rosbag(pop_period: timedelta,
             while (t - cur_time.timestamp() * 1e9) > pop_period.total_seconds() * 1e9:
                 cur_time = next(pop_gen)
 
-                estimates = {}
-                for topic_name in topics_of_interest:
-                    id = name_shortening_LUT[topic_name]
-                    estimates[id] = Estimates(
-                        period=buffer.estimated_period(id),
-                        period_stddev=buffer.estimated_period_stddev(id),
-                        period_jitter=buffer.estimated_period_jitter(id, buffer_params.jitter_quantile),
-                        latency=buffer.estimated_latency(id),
-                        latency_stddev=buffer.estimated_latency_stddev(id),
-                        latency_jitter=buffer.estimated_latency_jitter(id, buffer_params.jitter_quantile)
-                    )
-
-                run_data.estimates[cur_time] = estimates
+                if isinstance(buffer_params, MLParams):
+                    estimates = {}
+                    for topic_name in topics_of_interest:
+                        id = source_id_LUT[topic_name]
+                        estimates[name_shortening_LUT[topic_name]] = Estimates(
+                            period=buffer.estimated_period(id),
+                            period_stddev=buffer.estimated_period_stddev(id),
+                            period_jitter=buffer.estimated_period_jitter(id, buffer_params.jitter_quantile),
+                            latency=buffer.estimated_latency(id),
+                            latency_stddev=buffer.estimated_latency_stddev(id),
+                            latency_jitter=buffer.estimated_latency_jitter(id, buffer_params.jitter_quantile)
+                        )
+
+                    run_data.estimates[cur_time] = estimates
 
                 res = buffer.pop(cur_time)
                 if len(res.data) > 0 or len(res.discarded_data) > 0:
@@ -141,7 +144,7 @@ def evaluate_rosbag(pop_period: timedelta,
             input = Input(id=name_shortening_LUT[topic],
                           meas_time=datetime.fromtimestamp(meas_stamp_ns / 1e9, UTC),
                           receipt_time=datetime.fromtimestamp(t / 1e9, UTC))
-            res = buffer.push(input.id, input.receipt_time, input.meas_time, input)
+            res = buffer.push(source_id_LUT[topic], input.receipt_time, input.meas_time, input)
 
             run_data.inputs[input.receipt_time] = input
             assert res == PushReturn.Ok, "Unable to push input to buffer"
@@ -157,6 +160,9 @@ if __name__ == "__main__":
     parser.add_argument('--pop_period', type=float, default=10, help="Pop period to use within the buffer evaluation [unit: milliseconds]")
     parser.add_argument('--topics', type=str, nargs='+', help="Topics to consider for the evaluation. Wildcards will be matched against"
                                                               "availabe topics within the rosbag.")
+    parser.add_argument('--compare_latency_models', action='store_true',
+                        help="Evaluate the gaussian and the empirical latency model on the same recording and compare "
+                             "the resulting buffer delays and discard rates.")
 
     args = parser.parse_args()
 
@@ -164,14 +170,31 @@ if __name__ == "__main__":
 
     pop_period = timedelta(milliseconds=args.pop_period)
 
-    buffer_params = Params()
+    buffer_params = MLParams()
     buffer_params.mode = Mode.Single
     buffer_params.jitter_quantile = 0.99
     buffer_params.max_jitter = timedelta(milliseconds=5)
     buffer_params.max_wait_duration_quantile = 0.99
 
+    if args.compare_latency_models:
+        comparison = {}
+        for name, latency_model in [("gaussian", LatencyModel.Gaussian), ("empirical", LatencyModel.Empirical)]:
+            buffer_params.estimator.latency_model = latency_model
+            comparison[name] = [evaluate_rosbag(pop_period=pop_period,
+                                                buffer_params=buffer_params,
+                                                rosbag_path=args.path,
+                                                topic_filter=args.topics)]
+        print_comparison(comparison, time_unit='ms')
+        exit(0)
+
+    # toggle here to switch between buffer implementations
+    # evaluated_params = buffer_params
+    evaluated_params = FLParams()
+    evaluated_params.delay_mean = timedelta(milliseconds=180)
+    # evaluated_params.delay_mean = timedelta(milliseconds=225)
+
     results = evaluate_rosbag(pop_period=pop_period,
-                              buffer_params=buffer_params,
+                              buffer_params=evaluated_params,
                               rosbag_path=args.path,
                               topic_filter=args.topics)
 
@@ -182,7 +205,7 @@ if __name__ == "__main__":
     for run_data in [results]:
         for pop_time, pop_result in run_data.outputs.items():
             for element in pop_result.data:
-                merged_id = element.id.split('_')[0]
+                merged_id = element.data.id.split('_')[0]
                 delay = pop_time - element.data.receipt_time
                 if merged_id not in delays:
                     delays[merged_id] = []
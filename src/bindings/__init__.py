@@ -1,5 +1,7 @@
 from ._minimal_latency_buffer import FLParams, FixedLagBuffer
-from ._minimal_latency_buffer import MLParams, MinimalLatencyBuffer
-from ._minimal_latency_buffer import Mode, BatchParams, MatchParams, PushReturn, TimeData, TimeDataList, PopReturn
+from ._minimal_latency_buffer import MLParams, MinimalLatencyBuffer, EstimatorParams, LatencyModel
+from ._minimal_latency_buffer import Mode, BatchParams, GridParams, AsOfParams, SpeculativeParams, MatchParams, MatchGroup, MatchGroupList, IdList, PushReturn, TimeData, TimeDataList, PopReturn
+from ._minimal_latency_buffer import MissingMember, MissingMemberList, SnapshotList, SnapshotLists, Chunk, ChunkList, TimeList, MeasList, Correction, CorrectionList, MissingSample, MissingSampleList
+from ._minimal_latency_buffer import SourceParams, DecimationPolicy, DecimationParams, LateRouting, DiscardPolicy, DiscardControlParams, JointLatencyParams
 
 
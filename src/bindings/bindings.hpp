@@ -8,9 +8,11 @@
 //#include <nanobind/stl/vector.h>
 #include <nanobind/stl/bind_vector.h>
 #include <nanobind/stl/optional.h>
+#include <nanobind/stl/shared_ptr.h>
 #include <nanobind/stl/chrono.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/tuple.h>
+#include <nanobind/stl/unordered_map.h>
 
 #include "minimal_latency_buffer/types.hpp"
 
@@ -19,6 +19,7 @@ void loadFixedLagBuffer(::nanobind::module_& bound_module)
       .def_rw("delay_quantile", &FixedLagBuffer::Params::delay_quantile)
       .def_rw("batch", &FixedLagBuffer::Params::batch)
       .def_rw("match", &FixedLagBuffer::Params::match)
+      .def_rw("grid", &FixedLagBuffer::Params::grid)
       .def("__repr__", [](const Params& params) {
         std::stringstream stream;
 
@@ -30,6 +31,10 @@ void loadFixedLagBuffer(::nanobind::module_& bound_module)
         {
           stream << "Params(mode=BATCH";
         }
+        else if (params.mode == mlb::BufferMode::GRID)
+        {
+          stream << "Params(mode=GRID";
+        }
         else
         {
           stream << "Params(mode=MATCH";
@@ -60,7 +65,8 @@ void loadFixedLagBuffer(::nanobind::module_& bound_module)
             dat.delay_stddev,
             dat.delay_quantile,
             dat.batch,
-            dat.match);
+            dat.match,
+            dat.grid);
       })
       .def("__setstate__", [](Params& dat, const nb::tuple &state) {
         new (&dat) Params (
@@ -70,7 +76,8 @@ void loadFixedLagBuffer(::nanobind::module_& bound_module)
             nb::cast<mlb::Duration>(state[3]),
             nb::cast<double>(state[4]),
             nb::cast<mlb::BatchParams>(state[5]),
-            nb::cast<mlb::MatchParams<SourceId>>(state[6])
+            nb::cast<mlb::MatchParams<SourceId>>(state[6]),
+            nb::cast<mlb::GridParams>(state[7])
         );
       });
 
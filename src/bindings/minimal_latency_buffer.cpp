@@ -8,9 +8,54 @@ namespace nb=nanobind;
 
 using MinimalLatencyBuffer = mlb::MinimalLatencyBuffer<MeasType, SourceId>;
 using Params = MinimalLatencyBuffer::Params;
+using EstimatorParams = MinimalLatencyBuffer::Estimator::Params;
 
 void loadMinimalLatencyBuffer(::nanobind::module_& bound_module)
 {
+  nb::enum_<mlb::LatencyModel>(bound_module, "LatencyModel")
+      .value("Gaussian", mlb::LatencyModel::GAUSSIAN)
+      .value("Empirical", mlb::LatencyModel::EMPIRICAL)
+      .export_values();
+
+  nb::class_<EstimatorParams>(bound_module, "EstimatorParams")
+      .def(nb::init<>())
+      .def_rw("alpha", &EstimatorParams::alpha)
+      .def_rw("latency_model", &EstimatorParams::latency_model)
+      .def_rw("latency_window_size", &EstimatorParams::latency_window_size)
+      .def_rw("use_clock_model", &EstimatorParams::use_clock_model)
+      .def_rw("clock_drift_stddev", &EstimatorParams::clock_drift_stddev)
+      .def_rw("change_detection", &EstimatorParams::change_detection)
+      .def_rw("change_drift", &EstimatorParams::change_drift)
+      .def_rw("change_threshold", &EstimatorParams::change_threshold)
+      .def_rw("change_alpha", &EstimatorParams::change_alpha)
+      .def_rw("change_num_updates", &EstimatorParams::change_num_updates)
+      .def("__getstate__", [](const EstimatorParams& dat) {
+        return std::make_tuple(
+            dat.alpha,
+            dat.latency_model,
+            dat.latency_window_size,
+            dat.use_clock_model,
+            dat.clock_drift_stddev,
+            dat.change_detection,
+            dat.change_drift,
+            dat.change_threshold,
+            dat.change_alpha,
+            dat.change_num_updates);
+      })
+      .def("__setstate__", [](EstimatorParams& dat, const nb::tuple &state) {
+        new (&dat) EstimatorParams (
+            nb::cast<double>(state[0]),
+            nb::cast<mlb::LatencyModel>(state[1]),
+            nb::cast<std::size_t>(state[2]),
+            nb::cast<bool>(state[3]),
+            nb::cast<double>(state[4]),
+            nb::cast<bool>(state[5]),
+            nb::cast<double>(state[6]),
+            nb::cast<double>(state[7]),
+            nb::cast<double>(state[8]),
+            nb::cast<std::size_t>(state[9])
+        );
+      });
 
   nb::class_<Params>(bound_module, "MLParams")
       .def(nb::init<>())
@@ -20,8 +65,17 @@ void loadMinimalLatencyBuffer(::nanobind::module_& bound_module)
       .def_rw("max_wait_duration_quantile", &Params::wait_confidence_quantile)
       .def_rw("max_abs_wait_jitter", &Params::max_abs_wait_jitter)
       .def_rw("max_wait_duration", &Params::max_total_wait_time)
+      .def_rw("estimator", &Params::estimator)
       .def_rw("batch", &Params::batch)
       .def_rw("match", &Params::match)
+      .def_rw("sources", &Params::sources)
+      .def_rw("discard_control", &Params::discard_control)
+      .def_rw("joint_latency", &Params::joint_latency)
+      .def_rw("grid", &Params::grid)
+      .def_rw("asof", &Params::asof)
+      .def_rw("speculative", &Params::speculative)
+      .def_rw("report_missing_samples", &Params::report_missing_samples)
+      .def_rw("discard_policy", &Params::discard_policy)
       .def("__repr__", [](const Params& params) {
         std::stringstream stream;
 
@@ -33,6 +87,14 @@ void loadMinimalLatencyBuffer(::nanobind::module_& bound_module)
         {
           stream << "Params(mode=BATCH";
         }
+        else if (params.mode == mlb::BufferMode::GRID)
+        {
+          stream << "Params(mode=GRID";
+        }
+        else if (params.mode == mlb::BufferMode::ASOF)
+        {
+          stream << "Params(mode=ASOF";
+        }
         else
         {
           stream << "Params(mode=MATCH";
@@ -59,8 +121,17 @@ void loadMinimalLatencyBuffer(::nanobind::module_& bound_module)
             dat.wait_confidence_quantile,
             dat.max_abs_wait_jitter,
             dat.max_total_wait_time,
+            dat.estimator,
             dat.batch,
-            dat.match);
+            dat.match,
+            dat.sources,
+            dat.discard_control,
+            dat.joint_latency,
+            dat.grid,
+            dat.asof,
+            dat.speculative,
+            dat.report_missing_samples,
+            dat.discard_policy);
       })
       .def("__setstate__", [](Params& dat, const nb::tuple &state) {
         new (&dat) Params (
@@ -71,8 +142,17 @@ void loadMinimalLatencyBuffer(::nanobind::module_& bound_module)
             nb::cast<double>(state[4]),
             nb::cast<mlb::Duration>(state[5]),
             nb::cast<mlb::Duration>(state[6]),
-            nb::cast<mlb::BatchParams>(state[7]),
-            nb::cast<mlb::MatchParams<SourceId>>(state[8])
+            nb::cast<EstimatorParams>(state[7]),
+            nb::cast<mlb::BatchParams>(state[8]),
+            nb::cast<mlb::MatchParams<SourceId>>(state[9]),
+            nb::cast<std::unordered_map<SourceId, mlb::SourceParams>>(state[10]),
+            nb::cast<mlb::DiscardControlParams>(state[11]),
+            nb::cast<mlb::JointLatencyParams>(state[12]),
+            nb::cast<mlb::GridParams>(state[13]),
+            nb::cast<mlb::AsOfParams<SourceId>>(state[14]),
+            nb::cast<mlb::SpeculativeParams>(state[15]),
+            nb::cast<bool>(state[16]),
+            nb::cast<mlb::DiscardPolicy>(state[17])
         );
       });
 
@@ -88,8 +168,53 @@ void loadMinimalLatencyBuffer(::nanobind::module_& bound_module)
       .def("estimated_period_stddev", &MinimalLatencyBuffer::getEstimatedPeriodStddev,
            "Getter for the estimated standard deviation of the period of the given data source.")
       .def("estimated_period_jitter", &MinimalLatencyBuffer::getEstimatedPeriodQuantile)
-      .def("push", &MinimalLatencyBuffer::push, "Push new data to the buffer.")
+      .def("set_source_params", &MinimalLatencyBuffer::setSourceParams,
+           "Set the parameter overrides of the given data source (applied without resetting the buffer).")
+      .def("clear_source_params", &MinimalLatencyBuffer::clearSourceParams,
+           "Remove all parameter overrides of the given data source.")
+      .def("source_params", &MinimalLatencyBuffer::getSourceParams,
+           "Getter for the parameter overrides of the given data source.")
+      .def("set_aggregator",
+           [](MinimalLatencyBuffer &buffer, SourceId id, nb::callable aggregator) {
+             buffer.setAggregator(id, [aggregator](MeasType &aggregate, MeasType &&sample) {
+               aggregate = aggregator(aggregate, sample);
+             });
+           },
+           nb::arg("id"), nb::arg("aggregator"),
+           "Merge the samples dropped by the decimation of the given data source into its next stored sample "
+           "(the callable returns the merge of the aggregate and a dropped sample).")
+      .def("set_assembler",
+           [](MinimalLatencyBuffer &buffer, SourceId id, nb::callable assembler) {
+             buffer.setAssembler(id, [assembler](MeasType &scan, MeasType &&part) {
+               scan = assembler(scan, part);
+             });
+           },
+           nb::arg("id"), nb::arg("assembler"),
+           "Assemble the multi-part measurements of the given data source "
+           "(the callable returns the merge of the assembled parts and the next part).")
+      .def("set_discard_callback",
+           [](MinimalLatencyBuffer &buffer, nb::callable callback) {
+             buffer.setDiscardCallback([callback](MinimalLatencyBuffer::TimeData_t &&element) {
+               callback(std::move(element));
+             });
+           },
+           nb::arg("callback"),
+           "Hand the discarded samples over to the callable (requires the discard policy Callback).")
+      .def("num_discarded_samples", &MinimalLatencyBuffer::getNumberOfDiscardedSamples,
+           "Number of discarded samples of the given data source (requires the discard policy Count).")
+      .def("num_stale_samples", &MinimalLatencyBuffer::getNumberOfStaleSamples,
+           "Number of samples of the source dropped since they exceeded their maximal age at the release.")
+      .def("effective_wait_quantile", &MinimalLatencyBuffer::getEffectiveWaitQuantile,
+           "Getter for the wait confidence quantile currently used for the given data source.")
+      .def("push", &MinimalLatencyBuffer::push, nb::arg("id"), nb::arg("receipt_time"), nb::arg("meas_time"),
+           nb::arg("data"), nb::arg("cost") = nb::none(),
+           "Push new data to the buffer (optionally with a cost feature, e.g. the payload size, the latency depends on).")
+      .def("push_part", &MinimalLatencyBuffer::pushPart, nb::arg("id"), nb::arg("receipt_time"), nb::arg("meas_time"),
+           nb::arg("data"), nb::arg("part_index"), nb::arg("num_parts"), nb::arg("cost") = nb::none(),
+           "Push a single part of a multi-part measurement, the measurement is pushed once all of its parts are received.")
       .def("pop", &MinimalLatencyBuffer::pop, "Remove data from the buffer (if possible).")
+      .def("watermark", &MinimalLatencyBuffer::getWatermark,
+           "Monotonic measurement time prior to which no further data will be released (excluding new sources).")
       .def("reset", &MinimalLatencyBuffer::reset, "Reset the whole buffer.")
       .def("total_size", &MinimalLatencyBuffer::total_size, "total size, i.e., size with placeholders, of the buffer")
       .def("num_queued_elements", &MinimalLatencyBuffer::getNumberOfQueuedElements, "Number of queued elements (excluding any placeholders).");
@@ -6,6 +6,11 @@ namespace mlb=minimal_latency_buffer;
 namespace nb=nanobind;
 
 using PopReturn = mlb::PopReturn<TimeData>;
+using MissingMember = mlb::MissingMember<SourceId>;
+using Snapshot = std::shared_ptr<const TimeData>;
+using Chunk = mlb::Chunk<SourceId, MeasType>;
+using Correction = mlb::Correction<TimeData>;
+using MissingSample = mlb::MissingSample<SourceId>;
 
 void loadTypes(::nanobind::module_& bound_module)
 {
@@ -13,6 +18,8 @@ void loadTypes(::nanobind::module_& bound_module)
       .value("Single", mlb::BufferMode::SINGLE)
       .value("Batch", mlb::BufferMode::BATCH)
       .value("Match", mlb::BufferMode::MATCH)
+      .value("Grid", mlb::BufferMode::GRID)
+      .value("AsOf", mlb::BufferMode::ASOF)
       .export_values();
 
   nb::class_<mlb::BatchParams>(bound_module, "BatchParams")
@@ -26,19 +33,247 @@ void loadTypes(::nanobind::module_& bound_module)
             nb::cast<mlb::Duration>(state[0])
         );});
 
+  nb::class_<mlb::GridParams>(bound_module, "GridParams")
+      .def(nb::init<>())
+      .def_rw("origin", &mlb::GridParams::origin)
+      .def_rw("period", &mlb::GridParams::period)
+      .def("__getstate__",[](const mlb::GridParams &dat) {
+        return std::make_tuple(dat.origin, dat.period);
+      })
+      .def("__setstate__",[](mlb::GridParams &pop, const nb::tuple &state){
+        new (&pop) mlb::GridParams(
+            nb::cast<Time>(state[0]),
+            nb::cast<mlb::Duration>(state[1])
+        );});
+
+  nb::class_<mlb::AsOfParams<SourceId>>(bound_module, "AsOfParams")
+      .def(nb::init<>())
+      .def_rw("reference_stream", &mlb::AsOfParams<SourceId>::reference_stream)
+      .def("__getstate__",[](const mlb::AsOfParams<SourceId> &dat) {
+        return std::make_tuple(dat.reference_stream);
+      })
+      .def("__setstate__",[](mlb::AsOfParams<SourceId> &pop, const nb::tuple &state){
+        new (&pop) mlb::AsOfParams<SourceId>(
+            nb::cast<SourceId>(state[0])
+        );});
+
+  nb::class_<mlb::SpeculativeParams>(bound_module, "SpeculativeParams")
+      .def(nb::init<>())
+      .def_rw("enabled", &mlb::SpeculativeParams::enabled)
+      .def_rw("max_retraction", &mlb::SpeculativeParams::max_retraction)
+      .def("__getstate__",[](const mlb::SpeculativeParams &dat) {
+        return std::make_tuple(dat.enabled, dat.max_retraction);
+      })
+      .def("__setstate__",[](mlb::SpeculativeParams &pop, const nb::tuple &state){
+        new (&pop) mlb::SpeculativeParams(
+            nb::cast<bool>(state[0]),
+            nb::cast<mlb::Duration>(state[1])
+        );});
+
+  // bind vector to prevent implicit conversions (nanobind does not allow to mix 'vector.h' and 'bind_vector.h')
+  nb::bind_vector<std::vector<SourceId>>(bound_module, "IdList")
+      .def("__getstate__", [](const std::vector<SourceId> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<SourceId> &dat, const nb::list &list) {
+        new (&dat) std::vector<SourceId>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<SourceId>(element));
+        }
+      });
+
+  nb::class_<mlb::MatchGroup<SourceId>>(bound_module, "MatchGroup")
+      .def(nb::init<>())
+      .def_rw("reference_stream", &mlb::MatchGroup<SourceId>::reference_stream)
+      .def_rw("sources", &mlb::MatchGroup<SourceId>::sources)
+      .def_rw("partial_deadline", &mlb::MatchGroup<SourceId>::partial_deadline)
+      .def_rw("max_tau", &mlb::MatchGroup<SourceId>::max_tau)
+      .def("__getstate__",[](const mlb::MatchGroup<SourceId> &dat) {
+        return std::make_tuple(
+            dat.reference_stream,
+            dat.sources,
+            dat.partial_deadline,
+            dat.max_tau);
+      })
+      .def("__setstate__",[](mlb::MatchGroup<SourceId> &pop, const nb::tuple &state){
+        new (&pop) mlb::MatchGroup<SourceId>(
+            nb::cast<SourceId>(state[0]),
+            nb::cast<std::vector<SourceId>>(state[1]),
+            nb::cast<std::optional<mlb::Duration>>(state[2]),
+            nb::cast<std::optional<mlb::Duration>>(state[3])
+        );});
+
+  nb::bind_vector<std::vector<mlb::MatchGroup<SourceId>>>(bound_module, "MatchGroupList")
+      .def("__getstate__", [](const std::vector<mlb::MatchGroup<SourceId>> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<mlb::MatchGroup<SourceId>> &dat, const nb::list &list) {
+        new (&dat) std::vector<mlb::MatchGroup<SourceId>>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<mlb::MatchGroup<SourceId>>(element));
+        }
+      });
+
   nb::class_<mlb::MatchParams<SourceId>>(bound_module, "MatchParams")
       .def(nb::init<>())
       .def_rw("reference_stream", &mlb::MatchParams<SourceId>::reference_stream)
       .def_rw("num_streams", &mlb::MatchParams<SourceId>::num_streams)
+      .def_rw("groups", &mlb::MatchParams<SourceId>::groups)
+      .def_rw("assignment_window", &mlb::MatchParams<SourceId>::assignment_window)
+      .def_rw("partial_deadline", &mlb::MatchParams<SourceId>::partial_deadline)
+      .def_rw("max_tau", &mlb::MatchParams<SourceId>::max_tau)
       .def("__getstate__",[](const mlb::MatchParams<SourceId> &dat) {
         return std::make_tuple(
             dat.reference_stream,
-            dat.num_streams);
+            dat.num_streams,
+            dat.groups,
+            dat.assignment_window,
+            dat.partial_deadline,
+            dat.max_tau);
       })
       .def("__setstate__",[](mlb::MatchParams<SourceId> &pop, const nb::tuple &state){
         new (&pop) mlb::MatchParams(
             nb::cast<SourceId>(state[0]),
-                nb::cast<std::size_t>(state[0])
+            nb::cast<std::size_t>(state[1]),
+            nb::cast<std::vector<mlb::MatchGroup<SourceId>>>(state[2]),
+            nb::cast<std::size_t>(state[3]),
+            nb::cast<std::optional<mlb::Duration>>(state[4]),
+            nb::cast<std::optional<mlb::Duration>>(state[5]),
+            nb::cast<std::optional<mlb::Duration>>(state[6])
+        );});
+
+  nb::enum_<mlb::DecimationPolicy>(bound_module, "DecimationPolicy")
+      .value("NoDecimation", mlb::DecimationPolicy::NONE)
+      .value("EveryNth", mlb::DecimationPolicy::EVERY_NTH)
+      .value("LatestPerInterval", mlb::DecimationPolicy::LATEST_PER_INTERVAL)
+      .export_values();
+
+  nb::enum_<mlb::DiscardPolicy>(bound_module, "DiscardPolicy")
+      .value("Collect", mlb::DiscardPolicy::COLLECT)
+      .value("Count", mlb::DiscardPolicy::COUNT)
+      .value("Callback", mlb::DiscardPolicy::CALLBACK)
+      .value("Drop", mlb::DiscardPolicy::DROP)
+      .export_values();
+
+  nb::enum_<mlb::LateRouting>(bound_module, "LateRouting")
+      .value("Discarded", mlb::LateRouting::DISCARDED)
+      .value("Late", mlb::LateRouting::LATE)
+      .export_values();
+
+  nb::class_<mlb::DecimationParams>(bound_module, "DecimationParams")
+      .def(nb::init<>())
+      .def_rw("policy", &mlb::DecimationParams::policy)
+      .def_rw("factor", &mlb::DecimationParams::factor)
+      .def_rw("interval", &mlb::DecimationParams::interval)
+      .def("__getstate__",[](const mlb::DecimationParams &dat) {
+        return std::make_tuple(dat.policy, dat.factor, dat.interval);
+      })
+      .def("__setstate__",[](mlb::DecimationParams &pop, const nb::tuple &state){
+        new (&pop) mlb::DecimationParams(
+            nb::cast<mlb::DecimationPolicy>(state[0]),
+            nb::cast<std::size_t>(state[1]),
+            nb::cast<mlb::Duration>(state[2])
+        );});
+
+  nb::class_<mlb::SourceParams>(bound_module, "SourceParams")
+      .def(nb::init<>())
+      .def_rw("max_wait_duration_quantile", &mlb::SourceParams::wait_confidence_quantile)
+      .def_rw("max_abs_wait_jitter", &mlb::SourceParams::max_abs_wait_jitter)
+      .def_rw("max_wait_duration", &mlb::SourceParams::max_total_wait_time)
+      .def_rw("decimation", &mlb::SourceParams::decimation)
+      .def_rw("chunked", &mlb::SourceParams::chunked)
+      .def_rw("assembly_timeout", &mlb::SourceParams::assembly_timeout)
+      .def_rw("reorder_window", &mlb::SourceParams::reorder_window)
+      .def_rw("best_effort", &mlb::SourceParams::best_effort)
+      .def_rw("late_routing", &mlb::SourceParams::late_routing)
+      .def_rw("max_age_at_release", &mlb::SourceParams::max_age_at_release)
+      .def_rw("report_stale", &mlb::SourceParams::report_stale)
+      .def("__getstate__",[](const mlb::SourceParams &dat) {
+        return std::make_tuple(
+            dat.wait_confidence_quantile,
+            dat.max_abs_wait_jitter,
+            dat.max_total_wait_time,
+            dat.decimation,
+            dat.chunked,
+            dat.assembly_timeout,
+            dat.reorder_window,
+            dat.best_effort,
+            dat.late_routing,
+            dat.max_age_at_release,
+            dat.report_stale);
+      })
+      .def("__setstate__",[](mlb::SourceParams &pop, const nb::tuple &state){
+        new (&pop) mlb::SourceParams(
+            nb::cast<std::optional<double>>(state[0]),
+            nb::cast<std::optional<mlb::Duration>>(state[1]),
+            nb::cast<std::optional<mlb::Duration>>(state[2]),
+            nb::cast<mlb::DecimationParams>(state[3]),
+            nb::cast<bool>(state[4]),
+            nb::cast<std::optional<mlb::Duration>>(state[5]),
+            nb::cast<std::optional<mlb::Duration>>(state[6]),
+            nb::cast<bool>(state[7]),
+            nb::cast<mlb::LateRouting>(state[8]),
+            nb::cast<std::optional<mlb::Duration>>(state[9]),
+            nb::cast<bool>(state[10])
+        );});
+
+  nb::class_<mlb::DiscardControlParams>(bound_module, "DiscardControlParams")
+      .def(nb::init<>())
+      .def_rw("enabled", &mlb::DiscardControlParams::enabled)
+      .def_rw("target_discard_rate", &mlb::DiscardControlParams::target_discard_rate)
+      .def_rw("gain", &mlb::DiscardControlParams::gain)
+      .def_rw("min_quantile", &mlb::DiscardControlParams::min_quantile)
+      .def_rw("max_quantile", &mlb::DiscardControlParams::max_quantile)
+      .def("__getstate__",[](const mlb::DiscardControlParams &dat) {
+        return std::make_tuple(
+            dat.enabled,
+            dat.target_discard_rate,
+            dat.gain,
+            dat.min_quantile,
+            dat.max_quantile);
+      })
+      .def("__setstate__",[](mlb::DiscardControlParams &pop, const nb::tuple &state){
+        new (&pop) mlb::DiscardControlParams(
+            nb::cast<bool>(state[0]),
+            nb::cast<double>(state[1]),
+            nb::cast<double>(state[2]),
+            nb::cast<double>(state[3]),
+            nb::cast<double>(state[4])
+        );});
+
+  nb::class_<mlb::JointLatencyParams>(bound_module, "JointLatencyParams")
+      .def(nb::init<>())
+      .def_rw("enabled", &mlb::JointLatencyParams::enabled)
+      .def_rw("max_time_offset", &mlb::JointLatencyParams::max_time_offset)
+      .def_rw("min_correlation", &mlb::JointLatencyParams::min_correlation)
+      .def_rw("alpha", &mlb::JointLatencyParams::alpha)
+      .def("__getstate__",[](const mlb::JointLatencyParams &dat) {
+        return std::make_tuple(
+            dat.enabled,
+            dat.max_time_offset,
+            dat.min_correlation,
+            dat.alpha);
+      })
+      .def("__setstate__",[](mlb::JointLatencyParams &pop, const nb::tuple &state){
+        new (&pop) mlb::JointLatencyParams(
+            nb::cast<bool>(state[0]),
+            nb::cast<mlb::Duration>(state[1]),
+            nb::cast<double>(state[2]),
+            nb::cast<double>(state[3])
         );});
 
   nb::enum_<mlb::PushReturn>(bound_module, "PushReturn")
@@ -99,21 +334,283 @@ void loadTypes(::nanobind::module_& bound_module)
         }
       });
 
+  nb::bind_vector<std::vector<Snapshot>>(bound_module, "SnapshotList")
+      .def("__getstate__", [](const std::vector<Snapshot> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<Snapshot> &dat, const nb::list &list) {
+        new (&dat) std::vector<Snapshot>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<Snapshot>(element));
+        }
+      });
+
+  nb::bind_vector<std::vector<std::vector<Snapshot>>>(bound_module, "SnapshotLists")
+      .def("__getstate__", [](const std::vector<std::vector<Snapshot>> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<std::vector<Snapshot>> &dat, const nb::list &list) {
+        new (&dat) std::vector<std::vector<Snapshot>>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<std::vector<Snapshot>>(element));
+        }
+      });
+
+  nb::class_<MissingMember>(bound_module, "MissingMember")
+      .def(nb::init<>())
+      .def_rw("ref_position", &MissingMember::ref_position)
+      .def_rw("id", &MissingMember::id)
+      .def("__getstate__",[](const MissingMember &dat) {
+        return std::make_tuple(dat.ref_position, dat.id);
+      })
+      .def("__setstate__",[](MissingMember &pop, const nb::tuple &state){
+        new (&pop) MissingMember(
+            nb::cast<std::size_t>(state[0]),
+            nb::cast<SourceId>(state[1])
+        );});
+
+  nb::bind_vector<std::vector<MissingMember>>(bound_module, "MissingMemberList")
+      .def("__getstate__", [](const std::vector<MissingMember> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<MissingMember> &dat, const nb::list &list) {
+        new (&dat) std::vector<MissingMember>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<MissingMember>(element));
+        }
+      });
+
+  nb::bind_vector<std::vector<Time>>(bound_module, "TimeList")
+      .def("__getstate__", [](const std::vector<Time> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<Time> &dat, const nb::list &list) {
+        new (&dat) std::vector<Time>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<Time>(element));
+        }
+      });
+
+  nb::bind_vector<std::vector<MeasType>>(bound_module, "MeasList")
+      .def("__getstate__", [](const std::vector<MeasType> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<MeasType> &dat, const nb::list &list) {
+        new (&dat) std::vector<MeasType>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<MeasType>(element));
+        }
+      });
+
+  nb::class_<Chunk>(bound_module, "Chunk")
+      .def(nb::init<>())
+      .def_rw("id", &Chunk::id)
+      .def_rw("position", &Chunk::position)
+      .def_rw("meas_times", &Chunk::meas_times)
+      .def_rw("receipt_times", &Chunk::receipt_times)
+      .def_rw("data", &Chunk::data)
+      .def("__len__", &Chunk::size)
+      .def("__getstate__",[](const Chunk &dat) {
+        return std::make_tuple(dat.id, dat.position, dat.meas_times, dat.receipt_times, dat.data);
+      })
+      .def("__setstate__",[](Chunk &pop, const nb::tuple &state){
+        new (&pop) Chunk(
+            nb::cast<SourceId>(state[0]),
+            nb::cast<std::size_t>(state[1]),
+            nb::cast<std::vector<Time>>(state[2]),
+            nb::cast<std::vector<Time>>(state[3]),
+            nb::cast<std::vector<MeasType>>(state[4])
+        );});
+
+  nb::bind_vector<std::vector<Chunk>>(bound_module, "ChunkList")
+      .def("__getstate__", [](const std::vector<Chunk> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<Chunk> &dat, const nb::list &list) {
+        new (&dat) std::vector<Chunk>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<Chunk>(element));
+        }
+      });
+
+  nb::class_<Correction>(bound_module, "Correction")
+      .def(nb::init<>())
+      .def_rw("sample", &Correction::sample)
+      .def_rw("num_retracted", &Correction::num_retracted)
+      .def("__getstate__",[](const Correction &dat) {
+        return std::make_tuple(dat.sample, dat.num_retracted);
+      })
+      .def("__setstate__",[](Correction &pop, const nb::tuple &state){
+        new (&pop) Correction(
+            nb::cast<TimeData>(state[0]),
+            nb::cast<std::size_t>(state[1])
+        );});
+
+  nb::bind_vector<std::vector<Correction>>(bound_module, "CorrectionList")
+      .def("__getstate__", [](const std::vector<Correction> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<Correction> &dat, const nb::list &list) {
+        new (&dat) std::vector<Correction>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<Correction>(element));
+        }
+      });
+
+  nb::class_<MissingSample>(bound_module, "MissingSample")
+      .def(nb::init<>())
+      .def_rw("id", &MissingSample::id)
+      .def_rw("earliest_meas_time", &MissingSample::earliest_meas_time)
+      .def_rw("latest_receipt_time", &MissingSample::latest_receipt_time)
+      .def("__getstate__",[](const MissingSample &dat) {
+        return std::make_tuple(dat.id, dat.earliest_meas_time, dat.latest_receipt_time);
+      })
+      .def("__setstate__",[](MissingSample &pop, const nb::tuple &state){
+        new (&pop) MissingSample(
+            nb::cast<SourceId>(state[0]),
+            nb::cast<Time>(state[1]),
+            nb::cast<Time>(state[2])
+        );});
+
+  nb::bind_vector<std::vector<MissingSample>>(bound_module, "MissingSampleList")
+      .def("__getstate__", [](const std::vector<MissingSample> &dat) {
+        nb::list list{};
+        for (auto const &element : dat)
+        {
+          list.append(element);
+        }
+        return list;
+      })
+      .def("__setstate__", [](std::vector<MissingSample> &dat, const nb::list &list) {
+        new (&dat) std::vector<MissingSample>;
+        dat.reserve(list.size());
+        for (auto const &element : list)
+        {
+          dat.push_back(nb::cast<MissingSample>(element));
+        }
+      });
+
   nb::class_<PopReturn>(bound_module, "PopReturn")
       .def(nb::init<>())
-      .def(nb::init< Time, std::vector<TimeData>, std::vector<TimeData>>(),
+      .def(nb::init< Time, std::vector<TimeData>, std::vector<TimeData>, std::vector<std::size_t>, std::vector<MissingMember>, std::vector<std::size_t>,
+                     std::vector<std::vector<Snapshot>>, std::vector<Chunk>, std::vector<Correction>,
+                     std::vector<MissingSample>, Time, std::vector<TimeData>, std::vector<TimeData>>(),
            nb::arg("buffer_time"),
            nb::arg("data") = std::vector<TimeData>(),
-           nb::arg("discarded_data") = std::vector<TimeData>()
+           nb::arg("discarded_data") = std::vector<TimeData>(),
+           nb::arg("match_groups") = std::vector<std::size_t>(),
+           nb::arg("missing_members") = std::vector<MissingMember>(),
+           nb::arg("batch_starts") = std::vector<std::size_t>(),
+           nb::arg("asof_snapshots") = std::vector<std::vector<Snapshot>>(),
+           nb::arg("chunks") = std::vector<Chunk>(),
+           nb::arg("corrections") = std::vector<Correction>(),
+           nb::arg("missing_samples") = std::vector<MissingSample>(),
+           nb::arg("watermark") = Time(),
+           nb::arg("late_data") = std::vector<TimeData>(),
+           nb::arg("stale_data") = std::vector<TimeData>()
       )
       .def_rw("buffer_time", &PopReturn::buffer_time)
       .def_rw("data", &PopReturn::data)
       .def_rw("discarded_data", &PopReturn::discarded_data)
-      .def("__getstate__",[](const PopReturn &pop) -> nb::tuple{
-        return nb::make_tuple(pop.buffer_time, pop.data, pop.discarded_data);
+      .def_rw("match_groups", &PopReturn::match_groups)
+      .def_rw("missing_members", &PopReturn::missing_members)
+      .def_rw("batch_starts", &PopReturn::batch_starts)
+      .def_rw("asof_snapshots", &PopReturn::asof_snapshots)
+      .def_rw("chunks", &PopReturn::chunks)
+      .def_rw("corrections", &PopReturn::corrections)
+      .def_rw("missing_samples", &PopReturn::missing_samples)
+      .def_rw("watermark", &PopReturn::watermark)
+      .def_rw("late_data", &PopReturn::late_data)
+      .def_rw("stale_data", &PopReturn::stale_data)
+      // the state is keyed by the field names, i.e., it does not depend on the order of the fields and states
+      // lacking any field (e.g., pickled prior to its introduction) restore the default value of the field
+      .def("__getstate__",[](const PopReturn &pop) -> nb::dict{
+        nb::dict state;
+        state["buffer_time"] = nb::cast(pop.buffer_time, nb::rv_policy::copy);
+        state["data"] = nb::cast(pop.data, nb::rv_policy::copy);
+        state["discarded_data"] = nb::cast(pop.discarded_data, nb::rv_policy::copy);
+        state["match_groups"] = nb::cast(pop.match_groups, nb::rv_policy::copy);
+        state["missing_members"] = nb::cast(pop.missing_members, nb::rv_policy::copy);
+        state["batch_starts"] = nb::cast(pop.batch_starts, nb::rv_policy::copy);
+        state["asof_snapshots"] = nb::cast(pop.asof_snapshots, nb::rv_policy::copy);
+        state["chunks"] = nb::cast(pop.chunks, nb::rv_policy::copy);
+        state["corrections"] = nb::cast(pop.corrections, nb::rv_policy::copy);
+        state["missing_samples"] = nb::cast(pop.missing_samples, nb::rv_policy::copy);
+        state["watermark"] = nb::cast(pop.watermark, nb::rv_policy::copy);
+        state["late_data"] = nb::cast(pop.late_data, nb::rv_policy::copy);
+        state["stale_data"] = nb::cast(pop.stale_data, nb::rv_policy::copy);
+        return state;
       })
-      .def("__setstate__",[](PopReturn &pop, const std::tuple<Time, std::vector<TimeData>, std::vector<TimeData>> &state){
-        new (&pop) PopReturn(std::get<0>(state), std::get<1>(state), std::get<2>(state));
+      .def("__setstate__",[](PopReturn &pop, const nb::dict &state){
+        new (&pop) PopReturn();
+        const auto restore = [&state](const char *name, auto &field) {
+          if (state.contains(name))
+          {
+            field = nb::cast<std::decay_t<decltype(field)>>(state[name]);
+          }
+        };
+        restore("buffer_time", pop.buffer_time);
+        restore("data", pop.data);
+        restore("discarded_data", pop.discarded_data);
+        restore("match_groups", pop.match_groups);
+        restore("missing_members", pop.missing_members);
+        restore("batch_starts", pop.batch_starts);
+        restore("asof_snapshots", pop.asof_snapshots);
+        restore("chunks", pop.chunks);
+        restore("corrections", pop.corrections);
+        restore("missing_samples", pop.missing_samples);
+        restore("watermark", pop.watermark);
+        restore("late_data", pop.late_data);
+        restore("stale_data", pop.stale_data);
       });
 
 }
@@ -1,17 +1,44 @@
 
 import pickle
+from datetime import timedelta
 from minimal_latency_buffer import MLParams, FLParams, PopReturn, Mode, BatchParams, MatchParams
 
 from minimal_latency_buffer import FLParams,MLParams
-from minimal_latency_buffer import Mode, BatchParams, MatchParams, PushReturn, TimeData, TimeDataList, PopReturn
+from minimal_latency_buffer import Mode, BatchParams, GridParams, AsOfParams, SpeculativeParams, MatchParams, PushReturn, TimeData, TimeDataList, PopReturn
+from minimal_latency_buffer import MatchGroup, MissingMember, Chunk, Correction, MissingSample, SourceParams, LateRouting, DiscardPolicy, DecimationParams, DiscardControlParams, JointLatencyParams, EstimatorParams, LatencyModel
 
 filename = 'test.pickle'
 
 ml_params = MLParams()
+ml_params.discard_policy = DiscardPolicy.Count
 fl_params = FLParams()
 batch_params = BatchParams()
+grid_params = GridParams()
+asof_params = AsOfParams()
+speculative_params = SpeculativeParams()
 match_params = MatchParams()
+match_group = MatchGroup()
+match_group.sources.append(1)
+match_params.groups.append(match_group)
+source_params = SourceParams()
+source_params.chunked = True
+source_params.assembly_timeout = timedelta(milliseconds=20)
+source_params.reorder_window = timedelta(milliseconds=5)
+source_params.best_effort = True
+source_params.late_routing = LateRouting.Late
+source_params.max_age_at_release = timedelta(milliseconds=200)
+source_params.report_stale = True
+decimation_params = DecimationParams()
+discard_control_params = DiscardControlParams()
+joint_latency_params = JointLatencyParams()
+estimator_params = EstimatorParams()
 pop_return = PopReturn()
+pop_return.missing_members.append(MissingMember())
+pop_return.chunks.append(Chunk())
+pop_return.corrections.append(Correction())
+pop_return.missing_samples.append(MissingSample())
+pop_return.late_data.append(TimeData())
+pop_return.stale_data.append(TimeData())
 push_return = PushReturn.Ok
 time_data = TimeData()
 time_data_list = TimeDataList()
@@ -21,7 +48,17 @@ types = [
     ml_params,
     fl_params,
     batch_params,
+    grid_params,
+    asof_params,
+    speculative_params,
     match_params,
+    match_group,
+    source_params,
+    decimation_params,
+    discard_control_params,
+    joint_latency_params,
+    estimator_params,
+    LatencyModel.Empirical,
     pop_return,
     push_return,
     time_data,
@@ -38,3 +75,12 @@ for element in types:
     with open(filename, 'rb') as f:
         pickle.load(f)
     print('success')
+
+# the state of a pop return is keyed by the field names, missing fields are restored with their default
+state = pop_return.__getstate__()
+del state['stale_data']
+restored = PopReturn.__new__(PopReturn)
+restored.__setstate__(state)
+assert len(restored.late_data) == 1
+assert len(restored.stale_data) == 0
+print('success')
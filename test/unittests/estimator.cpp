@@ -1,3 +1,4 @@
+#include <array>
 #include "gtest/gtest.h"
 
 #include "minimal_latency_buffer/stream_characteristics_estimator.hpp"
@@ -103,4 +104,173 @@ TEST(Estimator, ErrorReportedUsingTracking)
 
 }
 
+TEST(Estimator, EmpiricalLatencyQuantiles)
+{
+  using namespace minimal_latency_buffer;
+  using namespace std::chrono_literals;
+  using Estimator = StreamCharacteristicsEstimator<std::chrono::high_resolution_clock, std::chrono::nanoseconds>;
+
+  Estimator::Params params;
+  params.latency_model = LatencyModel::EMPIRICAL;
+  params.latency_window_size = 100;
+
+  Estimator gaussian(Estimator::Time(10ms), Estimator::Time(0ms));
+  Estimator empirical(Estimator::Time(10ms), Estimator::Time(0ms), params);
+  EXPECT_FALSE(gaussian.usesEmpiricalLatency());
+  EXPECT_FALSE(empirical.usesEmpiricalLatency());
+
+  // bimodal latency: every tenth sample is delayed by 50ms instead of 10ms
+  constexpr auto update_period = 100ms;
+  for (std::size_t idx{1}; idx < 200; ++idx)
+  {
+    const auto meas_time = idx * update_period;
+    const auto latency = (idx % 10 == 0) ? 50ms : 10ms;
+    push_update(gaussian, meas_time + latency, meas_time);
+    push_update(empirical, meas_time + latency, meas_time);
+  }
+
+  EXPECT_TRUE(empirical.usesEmpiricalLatency());
+  EXPECT_EQ(empirical.latency_quantile(0.5), 10ms);
+  EXPECT_EQ(empirical.latency_quantile(0.95), 50ms);
+
+  // the gauss distribution misses the tail of the latency distribution
+  EXPECT_LT(gaussian.latency_quantile(0.95), 50ms);
+
+  // mean and variance are estimated independent of the latency model
+  EXPECT_EQ(gaussian.latency(), empirical.latency());
+  EXPECT_EQ(gaussian.latency_stddev(), empirical.latency_stddev());
+}
+
+TEST(Estimator, ClockModel)
+{
+  using namespace minimal_latency_buffer;
+  using namespace std::chrono_literals;
+  using Estimator = StreamCharacteristicsEstimator<std::chrono::high_resolution_clock, std::chrono::nanoseconds>;
+
+  Estimator::Params params;
+  params.use_clock_model = true;
+
+  // slightly drifting clock (50.01ms instead of 50ms) with time stamp jitter of up to 1ms
+  constexpr auto true_period = 50010us;
+  const std::array<std::chrono::microseconds, 5> jitter{ 800us, -500us, 300us, -900us, 200us };
+
+  Estimator estimator(Estimator::Time(10ms), Estimator::Time(0ms), params);
+  EXPECT_FALSE(estimator.usesClockModel());
+
+  std::chrono::nanoseconds last_meas_time{};
+  for (std::size_t idx{1}; idx < 500; ++idx)
+  {
+    // every seventh measurement is dropped, the number of missing measurements is determined by the clock model
+    if (idx % 7 == 0)
+    {
+      continue;
+    }
+    last_meas_time = idx * true_period + jitter[idx % jitter.size()];
+    EXPECT_NO_THROW(push_update(estimator, last_meas_time + 10ms, last_meas_time));
+  }
+
+  ASSERT_TRUE(estimator.usesClockModel());
+  EXPECT_NEAR(estimator.period().count(), std::chrono::nanoseconds(true_period).count(), 100'000);
+
+  // the prediction is based on the time grid instead of the (jittered) latest time stamp
+  const auto expected_meas_time = 501 * true_period;
+  const auto predicted_meas_time = estimator.predicted_meas_time(Estimator::Time(last_meas_time), 2);
+  EXPECT_NEAR(predicted_meas_time.time_since_epoch().count(), std::chrono::nanoseconds(expected_meas_time).count(), 500'000);
+  EXPECT_GT(estimator.predicted_meas_time_stddev(Estimator::Time(last_meas_time), 2), 0ns);
+  EXPECT_LT(estimator.predicted_meas_time_stddev(Estimator::Time(last_meas_time), 2), 2ms);
+}
+
+TEST(Estimator, ChangeDetection)
+{
+  using namespace minimal_latency_buffer;
+  using namespace std::chrono_literals;
+  using Estimator = StreamCharacteristicsEstimator<std::chrono::high_resolution_clock, std::chrono::nanoseconds>;
+
+  Estimator::Params params;
+  params.change_detection = true;
+
+  Estimator fixed(Estimator::Time(100ms), Estimator::Time(0ms));
+  Estimator adaptive(Estimator::Time(100ms), Estimator::Time(0ms), params);
+
+  // latency jumps from 100ms to 25ms, the jitter of the latency stays within +-10ms
+  const std::array<std::chrono::milliseconds, 5> jitter{ 8ms, -5ms, 3ms, -9ms, 3ms };
+  constexpr auto update_period = 50ms;
+  constexpr std::size_t change_idx = 500;
+  for (std::size_t idx{1}; idx < change_idx + 10; ++idx)
+  {
+    const auto meas_time = idx * update_period;
+    const auto latency = ((idx < change_idx) ? 100ms : 25ms) + jitter[idx % jitter.size()];
+    push_update(fixed, meas_time + latency, meas_time);
+    push_update(adaptive, meas_time + latency, meas_time);
+
+    if (idx + 1 == change_idx)
+    {
+      // no false alarms within the stationary phase
+      EXPECT_EQ(adaptive.getNumDetectedChanges(), 0);
+    }
+  }
+
+  EXPECT_EQ(fixed.getNumDetectedChanges(), 0);
+  EXPECT_EQ(adaptive.getNumDetectedChanges(), 1);
+
+  // shortly after the change only the adaptive estimator is close to the new latency
+  EXPECT_GT(fixed.latency(), 50ms);
+  EXPECT_LT(adaptive.latency(), 35ms);
+}
+
+TEST(Estimator, CostRegression)
+{
+  using namespace minimal_latency_buffer;
+  using namespace std::chrono_literals;
+  using Estimator = StreamCharacteristicsEstimator<std::chrono::high_resolution_clock, std::chrono::nanoseconds>;
+
+  Estimator estimator(Estimator::Time(10ms), Estimator::Time(0ms));
+  EXPECT_FALSE(estimator.usesCostModel());
+
+  // latency consists of 10ms base latency and 1ms per cost unit (e.g., 1ms per 100kB)
+  const std::array<double, 4> costs{ 0, 40, 10, 20 };
+  constexpr auto update_period = 100ms;
+  for (std::size_t idx{1}; idx < 200; ++idx)
+  {
+    const double cost = costs[idx % costs.size()];
+    const auto meas_time = idx * update_period;
+    const auto latency = 10ms + std::chrono::microseconds(static_cast<int64_t>(cost * 1000));
+    estimator.update(Estimator::Time(meas_time + latency), Estimator::Time(meas_time), 0, cost);
+  }
+
+  ASSERT_TRUE(estimator.usesCostModel());
+  EXPECT_DOUBLE_EQ(estimator.expected_cost(), costs[199 % costs.size()]);
+  EXPECT_NEAR(estimator.predicted_latency(0).count(), std::chrono::nanoseconds(10ms).count(), 100'000);
+  EXPECT_NEAR(estimator.predicted_latency(40).count(), std::chrono::nanoseconds(50ms).count(), 100'000);
+
+  // the cost explains the variation of the latency
+  EXPECT_GT(estimator.latency_stddev(), 10ms);
+  EXPECT_LT(estimator.predicted_latency_stddev(), 1ms);
+  // the cost of the next sample is unknown, the changes of the cost are considered for its latency
+  EXPECT_GT(estimator.expected_latency_stddev(), 10ms);
+}
+
+TEST(QuantileSketch, SlidingWindow)
+{
+  SlidingWindowQuantileSketch sketch(5);
+  EXPECT_EQ(sketch.quantile(0.5), 0);
+
+  for (int idx{1}; idx <= 5; ++idx)
+  {
+    sketch.add(idx);
+  }
+  EXPECT_EQ(sketch.size(), 5);
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.0), 1);
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 3);
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.625), 3.5);
+  EXPECT_DOUBLE_EQ(sketch.quantile(1.0), 5);
+
+  // oldest samples are replaced once the window is full
+  sketch.add(10);
+  sketch.add(10);
+  EXPECT_EQ(sketch.size(), 5);
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.0), 3);
+  EXPECT_DOUBLE_EQ(sketch.quantile(1.0), 10);
+}
+
 }  // namespace min_latency_buffer::test
@@ -74,6 +74,30 @@ TEST_P(FixedLagBufferSingleSource, InSequenceMeasurements)
   }
 }
 
+TEST_P(FixedLagBufferSingleSource, WatermarkAdvancesWithoutOutput)
+{
+  using namespace minimal_latency_buffer;
+
+  params.mode = GetParam() == "single" ? BufferMode::SINGLE : BufferMode::BATCH;
+  params.delay_mean = std::chrono::milliseconds(20);
+  FixedLagBuffer buffer(params);
+
+  auto meas = std::move(measurements.front());
+  measurements.pop_front();
+  const auto meas_stamp = meas->_meas_stamp;
+  EXPECT_EQ(buffer.push(0, meas->_receipt_stamp, meas_stamp, std::move(meas)), PushReturn::OK);
+
+  const auto first = buffer.pop(meas_stamp + std::chrono::milliseconds(40));
+  EXPECT_EQ(first.data.size(), 1);
+  EXPECT_GE(first.watermark, meas_stamp);
+
+  // nothing is released, but the watermark still follows the pop time
+  const auto second = buffer.pop(meas_stamp + std::chrono::milliseconds(100));
+  EXPECT_TRUE(second.data.empty());
+  EXPECT_GT(second.watermark, first.watermark);
+  EXPECT_EQ(buffer.getWatermark(), second.watermark);
+}
+
 INSTANTIATE_TEST_SUITE_P(FixedLagBufferSingleSource,
                          FixedLagBufferSingleSource,
                          testing::Values("single", "batch"));
@@ -161,4 +161,30 @@ TEST_F(FixedLagBufferTwoSources, Matching)
   pop_expect_data(buffer, 250ms + delay, 2, 0);
 }
 
+TEST_F(FixedLagBufferTwoSources, MatchingBacklog)
+{
+  params.mode = BufferMode::MATCH;
+  params.match.reference_stream = 50U;
+  params.match.num_streams = 2;
+
+  FixedLagBuffer buffer(params);
+
+  constexpr auto SENSOR_A = 50U;
+  constexpr auto SENSOR_B = 100U;
+
+  // three cycles are received without any pop in between
+  push_expect_ok(buffer, SENSOR_A, 60ms, 50ms);
+  push_expect_ok(buffer, SENSOR_B, 62ms, 52ms);
+  push_expect_ok(buffer, SENSOR_A, 110ms, 100ms);
+  push_expect_ok(buffer, SENSOR_B, 112ms, 102ms);
+  push_expect_ok(buffer, SENSOR_A, 160ms, 150ms);
+  push_expect_ok(buffer, SENSOR_B, 162ms, 152ms);
+  push_expect_ok(buffer, SENSOR_A, 210ms, 200ms);
+
+  // all complete tuples are emitted at once, the latest reference has to wait for its partner
+  auto result = pop_expect_data(buffer, 1s, 6);
+  EXPECT_EQ(result.buffer_time, Time(152ms));
+  EXPECT_EQ(buffer.getNumberOfQueuedElements(), 1);
+}
+
 }  // namespace minimal_latency_buffer::test
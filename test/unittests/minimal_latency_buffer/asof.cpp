@@ -0,0 +1,64 @@
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "../utils.hpp"
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferAsOf : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    params.mode = BufferMode::ASOF;
+    params.asof.reference_stream = SENSOR_A;
+  }
+
+  MinimalLatencyBuffer::Params params;
+
+  // period: 50ms, latency: 10ms
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms, measurement time offset: 5ms
+  static constexpr auto SENSOR_B = 100U;
+};
+
+TEST_F(MinimalLatencyBufferAsOf, doesNotWaitForOtherSources)
+{
+  MinimalLatencyBuffer buffer(params);
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    buffer.pop(Time(meas_stamp + 10ms));
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 15ms, meas_stamp - 45ms);
+    buffer.pop(Time(meas_stamp + 15ms));
+  }
+
+  // the reference is released immediately with the latest sample of the slow sensor
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  auto result = pop_expect_data(buffer, 1060ms, 1);
+  ASSERT_EQ(result.asof_snapshots.size(), 1);
+  ASSERT_EQ(result.asof_snapshots.front().size(), 1);
+  const auto snapshot = result.asof_snapshots.front().front();
+  EXPECT_EQ(snapshot->id, SENSOR_B);
+  EXPECT_EQ(snapshot->meas_time, Time(955ms));
+
+  // the late sample of the slow sensor is kept for upcoming references
+  push_expect_ok(buffer, SENSOR_B, 1065ms, 1005ms);
+  pop_expect_data(buffer, 1065ms, 0);
+  push_expect_ok(buffer, SENSOR_A, 1110ms, 1100ms);
+  result = pop_expect_data(buffer, 1110ms, 1);
+  EXPECT_EQ(result.asof_snapshots.front().front()->meas_time, Time(1005ms));
+
+  // the snapshot is shared instead of copied as long as no newer sample has been received
+  push_expect_ok(buffer, SENSOR_A, 1160ms, 1150ms);
+  auto next_result = pop_expect_data(buffer, 1160ms, 1);
+  EXPECT_EQ(next_result.asof_snapshots.front().front().get(), result.asof_snapshots.front().front().get());
+  EXPECT_EQ(buffer.getNumberOfQueuedElements(), 0);
+}
+
+}  // namespace minimal_latency_buffer::test
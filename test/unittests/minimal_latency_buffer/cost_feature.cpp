@@ -0,0 +1,121 @@
+#include <array>
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "../utils.hpp"
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferCostFeature : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // parametrization of the buffer is shared across all tests
+    params.max_total_wait_time = std::chrono::milliseconds(200);
+  }
+
+  /**
+   * Pushes samples of sensor B with a latency depending on the cost (10ms base latency, 1ms per cost unit).
+   * @return Measurement time of the latest pushed sample.
+   */
+  static Duration push_samples(MinimalLatencyBuffer &buffer, bool provide_cost)
+  {
+    // large samples (cost: 40) are followed by small samples (cost: 0)
+    const std::array<double, 10> costs{ 40, 40, 40, 40, 40, 0, 0, 0, 0, 0 };
+    Duration meas_stamp{};
+    for (std::size_t idx{1}; idx < 200; ++idx)
+    {
+      const double cost = costs[idx % costs.size()];
+      meas_stamp = idx * 50ms;
+      const Duration receipt_stamp = meas_stamp + 10ms + std::chrono::milliseconds(static_cast<int64_t>(cost));
+      const auto status = buffer.push(SENSOR_B, Time(receipt_stamp), Time(meas_stamp),
+                                      std::make_unique<Measurement>(Time(meas_stamp), Time(receipt_stamp)),
+                                      provide_cost ? std::optional<double>(cost) : std::nullopt);
+      EXPECT_EQ(status, PushReturn::OK);
+      pop_expect_data(buffer, receipt_stamp, 1);
+    }
+    return meas_stamp;
+  }
+
+  MinimalLatencyBuffer::Params params;
+
+  // period: 50ms, latency: 10ms
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 10ms - 50ms (depending on the cost of the sample)
+  static constexpr auto SENSOR_B = 100U;
+};
+
+TEST_F(MinimalLatencyBufferCostFeature, waitCoversCostChange)
+{
+  MinimalLatencyBuffer buffer(params);
+  const Duration last_meas_stamp = push_samples(buffer, true);
+
+  // the latest sample of sensor B was small, but the next one is large: the wait accounts for the changes of the cost
+  // (the buffer waits shorter than without the cost feature nonetheless, see below)
+  push_expect_ok(buffer, SENSOR_A, last_meas_stamp + 56ms, last_meas_stamp + 51ms);
+  pop_expect_data(buffer, last_meas_stamp + 56ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 99ms, 0);
+  ASSERT_EQ(buffer.push(SENSOR_B, Time(last_meas_stamp + 100ms), Time(last_meas_stamp + 50ms),
+                        std::make_unique<Measurement>(Time(last_meas_stamp + 50ms), Time(last_meas_stamp + 100ms)), 40),
+            PushReturn::OK);
+  pop_expect_data(buffer, last_meas_stamp + 100ms, 2);
+  pop_expect_data(buffer, last_meas_stamp + 110ms, 0);
+}
+
+TEST_F(MinimalLatencyBufferCostFeature, alternatingSmallAndLargeSamples)
+{
+  MinimalLatencyBuffer buffer(params);
+
+  // every third sample of sensor B is large, i.e., the latest costs are a poor prediction of the next one
+  std::size_t num_discarded{0};
+  for (std::size_t idx{1}; idx < 200; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    const double cost = idx % 3 == 0 ? 40 : 0;
+    const Duration receipt_stamp = meas_stamp + 10ms + std::chrono::milliseconds(static_cast<int64_t>(cost));
+    const auto push_b = [&] {
+      EXPECT_EQ(buffer.push(SENSOR_B, Time(receipt_stamp), Time(meas_stamp),
+                            std::make_unique<Measurement>(Time(meas_stamp), Time(receipt_stamp)), cost),
+                PushReturn::OK);
+      const auto result = buffer.pop(Time(receipt_stamp));
+      num_discarded += idx > 20 ? result.discarded_data.size() : 0;
+    };
+
+    if (cost == 0)
+    {
+      push_b();
+    }
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 11ms, meas_stamp + 1ms);
+    for (const Duration pop_stamp : { meas_stamp + 11ms, meas_stamp + 45ms })
+    {
+      const auto result = buffer.pop(Time(pop_stamp));
+      num_discarded += idx > 20 ? result.discarded_data.size() : 0;
+    }
+    if (cost > 0)
+    {
+      push_b();
+    }
+  }
+
+  // a large sample following a small one is still waited for
+  EXPECT_EQ(num_discarded, 0);
+}
+
+TEST_F(MinimalLatencyBufferCostFeature, waitForWorstCaseWithoutCost)
+{
+  MinimalLatencyBuffer buffer(params);
+  const Duration last_meas_stamp = push_samples(buffer, false);
+
+  // without cost feature the buffer has to wait for the large samples as well
+  push_expect_ok(buffer, SENSOR_A, last_meas_stamp + 56ms, last_meas_stamp + 51ms);
+  pop_expect_data(buffer, last_meas_stamp + 56ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 75ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 150ms, 1);
+}
+
+}  // namespace minimal_latency_buffer::test
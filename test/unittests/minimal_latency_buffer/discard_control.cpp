@@ -0,0 +1,103 @@
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "../utils.hpp"
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferDiscardControl : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // parametrization of the buffer is shared across all tests
+    params.max_total_wait_time = std::chrono::milliseconds(100);
+    params.wait_confidence_quantile = 0.9;
+    params.discard_control.enabled = true;
+    params.discard_control.target_discard_rate = 0.1;
+  }
+
+  MinimalLatencyBuffer::Params params;
+
+  // period: 50ms, latency: 10ms
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms
+  static constexpr auto SENSOR_B = 100U;
+};
+
+TEST_F(MinimalLatencyBufferDiscardControl, adaptsWaitQuantile)
+{
+  MinimalLatencyBuffer buffer(params);
+
+  // controller starts with the configured quantile
+  EXPECT_DOUBLE_EQ(buffer.getEffectiveWaitQuantile(SENSOR_B), 0.9);
+
+  push_expect_ok(buffer, SENSOR_B, 110ms, 50ms);
+  pop_expect_data(buffer, 110ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 160ms, 100ms);
+  pop_expect_data(buffer, 160ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 210ms, 150ms);
+  pop_expect_data(buffer, 210ms, 1);
+
+  // every sample which is not discarded allows to wait a little shorter
+  const double relaxed_quantile = buffer.getEffectiveWaitQuantile(SENSOR_B);
+  EXPECT_LT(relaxed_quantile, 0.9);
+  EXPECT_DOUBLE_EQ(buffer.getEffectiveWaitQuantile(SENSOR_A), 0.9);
+
+  // sample of sensor B arrives after its placeholder expired (latest receipt time: 260ms)
+  push_expect_ok(buffer, SENSOR_A, 220ms, 210ms);
+  pop_expect_data(buffer, 220ms, 0);
+  pop_expect_data(buffer, 261ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 265ms, 200ms);
+  pop_expect_data(buffer, 265ms, 0, 1);
+
+  // a miss requires waiting longer
+  EXPECT_GT(buffer.getEffectiveWaitQuantile(SENSOR_B), relaxed_quantile);
+  EXPECT_LE(buffer.getEffectiveWaitQuantile(SENSOR_B), params.discard_control.max_quantile);
+}
+
+TEST_F(MinimalLatencyBufferDiscardControl, runtimeOverrideRestartsControl)
+{
+  MinimalLatencyBuffer buffer(params);
+
+  push_expect_ok(buffer, SENSOR_B, 110ms, 50ms);
+  pop_expect_data(buffer, 110ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 160ms, 100ms);
+  pop_expect_data(buffer, 160ms, 1);
+  EXPECT_LT(buffer.getEffectiveWaitQuantile(SENSOR_B), 0.9);
+
+  // an override set at runtime takes precedence over the adapted quantile and is adapted afterwards
+  SourceParams source_params;
+  source_params.wait_confidence_quantile = 0.95;
+  buffer.setSourceParams(SENSOR_B, source_params);
+  EXPECT_DOUBLE_EQ(buffer.getEffectiveWaitQuantile(SENSOR_B), 0.95);
+
+  push_expect_ok(buffer, SENSOR_B, 210ms, 150ms);
+  pop_expect_data(buffer, 210ms, 1);
+  EXPECT_LT(buffer.getEffectiveWaitQuantile(SENSOR_B), 0.95);
+  EXPECT_GT(buffer.getEffectiveWaitQuantile(SENSOR_B), 0.9);
+
+  // removing the override restarts from the global quantile
+  buffer.clearSourceParams(SENSOR_B);
+  EXPECT_DOUBLE_EQ(buffer.getEffectiveWaitQuantile(SENSOR_B), 0.9);
+}
+
+TEST_F(MinimalLatencyBufferDiscardControl, lateSamplesWithoutPlaceholderAreIgnored)
+{
+  MinimalLatencyBuffer buffer(params);
+
+  push_expect_ok(buffer, SENSOR_A, 60ms, 50ms);
+  pop_expect_data(buffer, 60ms, 1);
+  const double quantile = buffer.getEffectiveWaitQuantile(SENSOR_B);
+
+  // first sample of sensor B is discarded, however, the buffer did never wait for it
+  push_expect_ok(buffer, SENSOR_B, 70ms, 10ms);
+  pop_expect_data(buffer, 70ms, 0, 1);
+  EXPECT_DOUBLE_EQ(buffer.getEffectiveWaitQuantile(SENSOR_B), quantile);
+}
+
+}  // namespace minimal_latency_buffer::test
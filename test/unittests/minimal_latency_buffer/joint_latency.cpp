@@ -0,0 +1,83 @@
+#include <array>
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "../utils.hpp"
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferJointLatency : public ::testing::Test
+{
+protected:
+  /**
+   * Pushes samples of both sensors whose latencies are affected by the same (shared link) jitter.
+   * @return Measurement time of the latest pushed sample of sensor A.
+   */
+  static Duration push_samples(MinimalLatencyBuffer &buffer, std::size_t num_samples)
+  {
+    Duration meas_stamp{};
+    for (std::size_t idx{1}; idx <= num_samples; ++idx)
+    {
+      meas_stamp = idx * 50ms;
+      const Duration shared_jitter = SHARED_JITTER[idx % SHARED_JITTER.size()];
+      push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms + shared_jitter, meas_stamp);
+      buffer.pop(Time(meas_stamp + 10ms + shared_jitter));
+      push_expect_ok(buffer, SENSOR_B, meas_stamp + 25ms + shared_jitter, meas_stamp - 5ms);
+      buffer.pop(Time(meas_stamp + 25ms + shared_jitter));
+    }
+    return meas_stamp;
+  }
+
+  MinimalLatencyBuffer::Params params;
+
+  static constexpr std::array<Duration, 5> SHARED_JITTER{ -4ms, 4ms, -2ms, 2ms, 0ms };
+
+  // period: 50ms, latency: 10ms +- shared jitter
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 30ms +- shared jitter, measurement time offset: -5ms
+  static constexpr auto SENSOR_B = 100U;
+};
+
+TEST_F(MinimalLatencyBufferJointLatency, earlyReleaseAfterFastSample)
+{
+  params.joint_latency.enabled = true;
+  MinimalLatencyBuffer buffer(params);
+  const Duration last_meas_stamp = push_samples(buffer, 99);
+
+  // sensor A is 4ms faster than usual, hence, the sample of sensor B is expected to be faster as well (it is dropped)
+  push_expect_ok(buffer, SENSOR_A, last_meas_stamp + 56ms, last_meas_stamp + 50ms);
+  pop_expect_data(buffer, last_meas_stamp + 56ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 76ms, 1);
+}
+
+TEST_F(MinimalLatencyBufferJointLatency, independentWaitingWithoutJointModel)
+{
+  MinimalLatencyBuffer buffer(params);
+  const Duration last_meas_stamp = push_samples(buffer, 99);
+
+  // the buffer waits for the full latency quantile of sensor B
+  push_expect_ok(buffer, SENSOR_A, last_meas_stamp + 56ms, last_meas_stamp + 50ms);
+  pop_expect_data(buffer, last_meas_stamp + 56ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 76ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 90ms, 1);
+}
+
+TEST_F(MinimalLatencyBufferJointLatency, longerWaitAfterSlowSample)
+{
+  params.joint_latency.enabled = true;
+  MinimalLatencyBuffer buffer(params);
+  const Duration last_meas_stamp = push_samples(buffer, 99);
+
+  // shared link hiccup: both samples are delayed by 15ms, the buffer keeps waiting for sensor B
+  push_expect_ok(buffer, SENSOR_A, last_meas_stamp + 75ms, last_meas_stamp + 50ms);
+  pop_expect_data(buffer, last_meas_stamp + 75ms, 0);
+  pop_expect_data(buffer, last_meas_stamp + 89ms, 0);
+  push_expect_ok(buffer, SENSOR_B, last_meas_stamp + 90ms, last_meas_stamp + 45ms);
+  pop_expect_data(buffer, last_meas_stamp + 90ms, 2);
+}
+
+}  // namespace minimal_latency_buffer::test
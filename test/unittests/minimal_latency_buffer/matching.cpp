@@ -0,0 +1,337 @@
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "../utils.hpp"
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferMatching : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    params.mode = BufferMode::MATCH;
+    params.match.reference_stream = SENSOR_A;
+  }
+
+  /**
+   * Pushes samples of both sensors, optionally popping after every push.
+   */
+  static void push_cycles(MinimalLatencyBuffer &buffer, std::size_t first, std::size_t last, bool pop)
+  {
+    for (std::size_t idx{first}; idx <= last; ++idx)
+    {
+      const Duration meas_stamp = idx * 50ms;
+      push_expect_ok(buffer, SENSOR_B, meas_stamp + 5ms, meas_stamp - 5ms);
+      if (pop)
+      {
+        buffer.pop(Time(meas_stamp + 5ms));
+      }
+      push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+      if (pop)
+      {
+        buffer.pop(Time(meas_stamp + 10ms));
+      }
+    }
+  }
+
+  MinimalLatencyBuffer::Params params;
+
+  // period: 50ms, latency: 10ms
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 10ms, measurement time offset: -5ms
+  static constexpr auto SENSOR_B = 100U;
+};
+
+TEST_F(MinimalLatencyBufferMatching, singleTupleInSteadyState)
+{
+  MinimalLatencyBuffer buffer(params);
+  push_cycles(buffer, 1, 20, true);
+
+  push_expect_ok(buffer, SENSOR_B, 1055ms, 1045ms);
+  pop_expect_data(buffer, 1055ms, 0);
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  auto result = pop_expect_data(buffer, 1060ms, 2);
+  EXPECT_EQ(result.data.front().id, SENSOR_B);
+  EXPECT_EQ(result.data.back().id, SENSOR_A);
+}
+
+TEST_F(MinimalLatencyBufferMatching, drainsBacklogWithinSinglePop)
+{
+  MinimalLatencyBuffer buffer(params);
+  push_cycles(buffer, 1, 20, true);
+
+  // stall: several cycles are received without any pop in between
+  push_cycles(buffer, 21, 25, false);
+
+  auto result = pop_expect_data(buffer, 1260ms, 10);
+  EXPECT_EQ(result.buffer_time, Time(1250ms));
+  for (std::size_t idx{0}; idx < result.data.size(); idx += 2)
+  {
+    EXPECT_EQ(result.data.at(idx).id, SENSOR_B);
+    EXPECT_EQ(result.data.at(idx + 1).id, SENSOR_A);
+  }
+  EXPECT_EQ(buffer.getNumberOfQueuedElements(), 0);
+}
+
+TEST_F(MinimalLatencyBufferMatching, partialTupleAfterDeadline)
+{
+  // period: 50ms, latency: 60ms
+  constexpr auto SENSOR_C = 150U;
+
+  params.match.partial_deadline = 20ms;
+  MinimalLatencyBuffer buffer(params);
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_C, meas_stamp + 10ms, meas_stamp - 50ms);
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    buffer.pop(Time(meas_stamp + 10ms));
+  }
+
+  push_expect_ok(buffer, SENSOR_C, 1060ms, 1000ms);
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  pop_expect_data(buffer, 1060ms, 2);
+
+  // the slow sensor is not awaited beyond the deadline of the reference
+  auto result = pop_expect_data(buffer, 1071ms, 1);
+  EXPECT_EQ(result.data.front().meas_time, Time(1050ms));
+  ASSERT_EQ(result.missing_members.size(), 1);
+  EXPECT_EQ(result.missing_members.front().ref_position, 0);
+  EXPECT_EQ(result.missing_members.front().id, SENSOR_C);
+}
+
+TEST_F(MinimalLatencyBufferMatching, tauToleranceRejectsPairing)
+{
+  params.match.max_tau = 3ms;
+  MinimalLatencyBuffer buffer(params);
+  push_cycles(buffer, 1, 20, true);
+
+  // the sample of sensor B is 5ms off, the reference can not form any tuple
+  push_expect_ok(buffer, SENSOR_B, 1055ms, 1045ms);
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  auto result = pop_expect_data(buffer, 1060ms, 0, 1);
+  EXPECT_EQ(result.discarded_data.front().id, SENSOR_A);
+}
+
+TEST_F(MinimalLatencyBufferMatching, partialTupleWithinTolerance)
+{
+  params.match.max_tau = 3ms;
+  params.match.partial_deadline = 20ms;
+  MinimalLatencyBuffer buffer(params);
+  push_cycles(buffer, 1, 20, true);
+
+  // the reference is released immediately without the sample exceeding the tolerance
+  push_expect_ok(buffer, SENSOR_B, 1055ms, 1045ms);
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  auto result = pop_expect_data(buffer, 1060ms, 1, 1);
+  EXPECT_EQ(result.data.front().id, SENSOR_A);
+  EXPECT_EQ(result.discarded_data.front().id, SENSOR_B);
+  ASSERT_EQ(result.missing_members.size(), 1);
+  EXPECT_EQ(result.missing_members.front().id, SENSOR_B);
+}
+
+class MinimalLatencyBufferAssignment : public MinimalLatencyBufferMatching,
+                                       public ::testing::WithParamInterface<std::size_t>
+{
+};
+
+TEST_P(MinimalLatencyBufferAssignment, jitteredSampleAfterDrop)
+{
+  params.match.assignment_window = GetParam();
+  MinimalLatencyBuffer buffer(params);
+  push_cycles(buffer, 1, 19, true);
+
+  // the sample of sensor B belonging to the reference at 1000ms is dropped and the following ones are jittered, such
+  // that the next sample fits slightly better to the subsequent reference
+  push_expect_ok(buffer, SENSOR_A, 1010ms, 1000ms);
+  push_expect_ok(buffer, SENSOR_B, 1036ms, 1026ms);
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  push_expect_ok(buffer, SENSOR_B, 1080ms, 1070ms);
+
+  if (GetParam() == 0)
+  {
+    // greedy matching: the reference at 1000ms is dropped, the sample at 1026ms is lost
+    auto result = pop_expect_data(buffer, 1080ms, 2, 2);
+    EXPECT_EQ(result.data.front().meas_time, Time(1050ms));
+  }
+  else
+  {
+    // optimal assignment: both references result in a tuple (the previous tuple waited for the candidate after its
+    // reference)
+    auto result = pop_expect_data(buffer, 1080ms, 6);
+    EXPECT_EQ(result.data.at(1).meas_time, Time(950ms));
+    EXPECT_EQ(result.data.at(2).meas_time, Time(1000ms));
+    EXPECT_EQ(result.data.at(3).meas_time, Time(1026ms));
+    EXPECT_EQ(result.data.at(4).meas_time, Time(1050ms));
+    EXPECT_EQ(result.data.at(5).meas_time, Time(1070ms));
+  }
+}
+
+TEST_P(MinimalLatencyBufferAssignment, tuplesDoNotInterleaveAcrossSources)
+{
+  // period: 100ms, latency: 10ms, measured 10ms before the reference
+  constexpr auto SENSOR_C = 150U;
+
+  params.match.assignment_window = GetParam();
+  MinimalLatencyBuffer buffer(params);
+
+  std::vector<Time> released;
+  const auto push_pop = [&](std::size_t id, Duration meas_stamp, bool pop) {
+    push_expect_ok(buffer, id, meas_stamp + 10ms, meas_stamp);
+    if (pop)
+    {
+      for (const auto &element : buffer.pop(Time(meas_stamp + 10ms)).data)
+      {
+        released.push_back(element.meas_time);
+      }
+    }
+  };
+
+  // the reference (period: 100ms) is followed by sensor B after 60ms, sensor C precedes it by 10ms
+  for (std::size_t idx{1}; idx <= 25; ++idx)
+  {
+    const Duration meas_stamp = idx * 100ms;
+    // the output stalls while the sample of sensor B at 2060ms is dropped and sensor C is jittered at 2155ms, such that
+    // sensor C fits best to the reference at 2200ms while sensor B at 2160ms solely fits to the reference at 2100ms
+    const bool pop = idx < 20 or idx > 22;
+    push_pop(SENSOR_C, idx == 22 ? meas_stamp - 45ms : meas_stamp - 10ms, pop);
+    push_pop(SENSOR_A, meas_stamp, pop);
+    if (idx != 20)
+    {
+      push_pop(SENSOR_B, meas_stamp + 60ms, pop);
+    }
+  }
+
+  EXPECT_FALSE(released.empty());
+  EXPECT_TRUE(std::is_sorted(released.begin(), released.end()));
+}
+
+TEST_F(MinimalLatencyBufferMatching, assignmentRejectsPartialDeadline)
+{
+  params.match.assignment_window = 4;
+  params.match.partial_deadline = 20ms;
+  EXPECT_THROW(MinimalLatencyBuffer{ params }, std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(MinimalLatencyBufferAssignment,
+                         MinimalLatencyBufferAssignment,
+                         testing::Values(0, 1, 4));
+
+TEST_F(MinimalLatencyBufferMatching, groupsReleaseIndependently)
+{
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_C = 150U;
+  // period: 50ms, latency: 60ms
+  constexpr auto SENSOR_D = 200U;
+
+  params.match.groups = { { .reference_stream = SENSOR_A, .sources = { SENSOR_B } },
+                          { .reference_stream = SENSOR_C, .sources = { SENSOR_D } } };
+  MinimalLatencyBuffer buffer(params);
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_D, meas_stamp + 10ms, meas_stamp - 50ms);
+    buffer.pop(Time(meas_stamp + 10ms));
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 5ms, meas_stamp - 5ms);
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    push_expect_ok(buffer, SENSOR_C, meas_stamp + 10ms, meas_stamp);
+    buffer.pop(Time(meas_stamp + 10ms));
+  }
+
+  // the first group does not wait for the slow sensor of the second group
+  push_expect_ok(buffer, SENSOR_B, 1055ms, 1045ms);
+  push_expect_ok(buffer, SENSOR_A, 1060ms, 1050ms);
+  push_expect_ok(buffer, SENSOR_C, 1060ms, 1050ms);
+  auto result = pop_expect_data(buffer, 1060ms, 2);
+  EXPECT_EQ(result.match_groups, std::vector<std::size_t>({ 0, 0 }));
+
+  // the second group releases as soon as its slow sensor is received
+  push_expect_ok(buffer, SENSOR_D, 1061ms, 1000ms);
+  result = pop_expect_data(buffer, 1061ms, 2);
+  EXPECT_EQ(result.match_groups, std::vector<std::size_t>({ 1, 1 }));
+  EXPECT_EQ(result.data.front().id, SENSOR_C);
+  EXPECT_EQ(result.buffer_time, Time(1000ms));
+}
+
+TEST_F(MinimalLatencyBufferMatching, sharedSourceWithinGroups)
+{
+  constexpr auto SENSOR_C = 150U;
+
+  // copyable data is required for sources taking part in several groups
+  using SharedBuffer = minimal_latency_buffer::MinimalLatencyBuffer<int>;
+  SharedBuffer::Params shared_params;
+  shared_params.mode = BufferMode::MATCH;
+  shared_params.match.groups = { { .reference_stream = SENSOR_A, .sources = { SENSOR_B } },
+                                 { .reference_stream = SENSOR_C, .sources = { SENSOR_B } } };
+  SharedBuffer buffer(shared_params);
+
+  SharedBuffer::PopReturn_t result;
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    EXPECT_EQ(buffer.push(SENSOR_B, Time(meas_stamp + 5ms), Time(meas_stamp - 5ms), 1), PushReturn::OK);
+    EXPECT_EQ(buffer.push(SENSOR_A, Time(meas_stamp + 10ms), Time(meas_stamp), 2), PushReturn::OK);
+    EXPECT_EQ(buffer.push(SENSOR_C, Time(meas_stamp + 10ms), Time(meas_stamp + 2ms), 3), PushReturn::OK);
+    result = buffer.pop(Time(meas_stamp + 10ms));
+  }
+
+  // the sample of the shared sensor is part of the tuples of both groups
+  ASSERT_EQ(result.data.size(), 4);
+  EXPECT_EQ(result.match_groups, std::vector<std::size_t>({ 0, 0, 1, 1 }));
+  EXPECT_EQ(result.data.at(0).data, 1);
+  EXPECT_EQ(result.data.at(2).data, 1);
+  EXPECT_EQ(result.data.at(3).data, 3);
+  EXPECT_TRUE(result.discarded_data.empty());
+  EXPECT_EQ(buffer.getNumberOfQueuedElements(), 0);
+}
+
+TEST_F(MinimalLatencyBufferMatching, sharedSampleReleasedOnce)
+{
+  // period: 50ms, latency: 28ms, not within the tolerance of sensor B
+  constexpr auto SENSOR_C = 150U;
+
+  using SharedBuffer = minimal_latency_buffer::MinimalLatencyBuffer<int>;
+  SharedBuffer::Params shared_params;
+  shared_params.mode = BufferMode::MATCH;
+  shared_params.match.groups = { { .reference_stream = SENSOR_A, .sources = { SENSOR_B } },
+                                 { .reference_stream = SENSOR_C, .sources = { SENSOR_B }, .max_tau = 1ms } };
+  SharedBuffer buffer(shared_params);
+
+  std::size_t num_released{ 0 };
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    EXPECT_EQ(buffer.push(SENSOR_B, Time(meas_stamp + 5ms), Time(meas_stamp - 5ms), 1), PushReturn::OK);
+    EXPECT_EQ(buffer.push(SENSOR_A, Time(meas_stamp + 10ms), Time(meas_stamp), 2), PushReturn::OK);
+    auto result = buffer.pop(Time(meas_stamp + 10ms));
+    num_released += std::count_if(result.data.begin(), result.data.end(),
+                                  [](const auto &element) { return element.id == SENSOR_B; });
+    EXPECT_TRUE(result.discarded_data.empty());
+
+    // the second group passes the sample of sensor B released by the first group without using it
+    EXPECT_EQ(buffer.push(SENSOR_C, Time(meas_stamp + 30ms), Time(meas_stamp + 2ms), 3), PushReturn::OK);
+    result = buffer.pop(Time(meas_stamp + 30ms));
+    for (const auto &element : result.discarded_data)
+    {
+      EXPECT_NE(element.id, SENSOR_B);
+    }
+  }
+  EXPECT_GT(num_released, 15);
+}
+
+TEST_F(MinimalLatencyBufferMatching, sharedSourceRequiresCopyableData)
+{
+  constexpr auto SENSOR_C = 150U;
+
+  params.match.groups = { { .reference_stream = SENSOR_A, .sources = { SENSOR_B } },
+                          { .reference_stream = SENSOR_C, .sources = { SENSOR_B } } };
+  EXPECT_THROW(MinimalLatencyBuffer buffer(params), std::invalid_argument);
+}
+
+}  // namespace minimal_latency_buffer::test
@@ -0,0 +1,133 @@
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferMultiPart : public ::testing::Test
+{
+protected:
+  using CountBuffer = minimal_latency_buffer::MinimalLatencyBuffer<int>;
+
+  void SetUp() override
+  {
+    params.max_total_wait_time = std::chrono::milliseconds(100);
+  }
+
+  /**
+   * Pushes the parts of a scan of sensor R in reversed order (first part received 10ms after the measurement, every
+   * further part 1ms later).
+   * @param discarded Optionally collects the measurements discarded by the pops after each part.
+   * @return Assembled measurements released by the pops after each part.
+   */
+  static std::vector<int> push_scan(CountBuffer &buffer, Duration meas_stamp, std::size_t num_received,
+                                    std::vector<int> *discarded = nullptr)
+  {
+    std::vector<int> output;
+    for (std::size_t idx{0}; idx < num_received; ++idx)
+    {
+      const Duration receipt_stamp = meas_stamp + 10ms + idx * 1ms;
+      EXPECT_EQ(buffer.pushPart(SENSOR_R, Time(receipt_stamp), Time(meas_stamp), 1, NUM_PARTS - 1 - idx, NUM_PARTS),
+                PushReturn::OK);
+      const auto result = buffer.pop(Time(receipt_stamp));
+      for (const auto &element : result.data)
+      {
+        output.push_back(*element.data);
+      }
+      for (const auto &element : result.discarded_data)
+      {
+        if (discarded != nullptr)
+        {
+          discarded->push_back(*element.data);
+        }
+      }
+    }
+    return output;
+  }
+
+  CountBuffer::Params params;
+
+  // period: 50ms, latency of the assembled scan: 12ms
+  static constexpr auto SENSOR_R = 200U;
+  static constexpr std::size_t NUM_PARTS = 3;
+};
+
+TEST_F(MinimalLatencyBufferMultiPart, assembledScans)
+{
+  CountBuffer buffer(params);
+  buffer.setAssembler(SENSOR_R, [](int &scan, int &&part) { scan += part; });
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    // each scan is released once as soon as its last part is received
+    EXPECT_EQ(push_scan(buffer, idx * 50ms, NUM_PARTS), std::vector<int>({ NUM_PARTS }));
+  }
+
+  // the parts are not considered as separate samples
+  EXPECT_EQ(buffer.getEstimatedPeriod(SENSOR_R), 50ms);
+  EXPECT_EQ(buffer.getEstimatedLatency(SENSOR_R), 12ms);
+}
+
+TEST_F(MinimalLatencyBufferMultiPart, incompleteScanTimeout)
+{
+  params.sources[SENSOR_R].assembly_timeout = 20ms;
+  CountBuffer buffer(params);
+  buffer.setAssembler(SENSOR_R, [](int &scan, int &&part) { scan += part; });
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    EXPECT_EQ(push_scan(buffer, idx * 50ms, NUM_PARTS), std::vector<int>({ NUM_PARTS }));
+  }
+
+  // the last part of the scan is lost, the remaining parts are released after the timeout
+  EXPECT_TRUE(push_scan(buffer, 1050ms, NUM_PARTS - 1).empty());
+  EXPECT_TRUE(buffer.pop(Time(1079ms)).data.empty());
+  const auto result = buffer.pop(Time(1080ms));
+  ASSERT_EQ(result.data.size(), 1);
+  EXPECT_EQ(*result.data.front().data, NUM_PARTS - 1);
+  EXPECT_EQ(result.data.front().meas_time, Time(1050ms));
+
+  // without a timeout, the incomplete scan is dropped once the next scan is completed
+  params.sources[SENSOR_R].assembly_timeout.reset();
+  buffer.setSourceParams(SENSOR_R, params.sources[SENSOR_R]);
+  EXPECT_TRUE(push_scan(buffer, 1100ms, NUM_PARTS - 1).empty());
+  EXPECT_EQ(buffer.getEarliestHoldBackReceptionTime(), Time(1110ms));
+  std::vector<int> discarded;
+  EXPECT_EQ(push_scan(buffer, 1150ms, NUM_PARTS, &discarded), std::vector<int>({ NUM_PARTS }));
+  EXPECT_EQ(buffer.getEarliestHoldBackReceptionTime(), Time::max());
+  // the dropped scan is handled according to the discard policy
+  EXPECT_EQ(discarded, std::vector<int>({ NUM_PARTS - 1 }));
+}
+
+TEST_F(MinimalLatencyBufferMultiPart, lateExpirationKeepsBuffer)
+{
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+
+  params.sources[SENSOR_R].assembly_timeout = 20ms;
+  CountBuffer buffer(params);
+  buffer.setAssembler(SENSOR_R, [](int &scan, int &&part) { scan += part; });
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    EXPECT_EQ(push_scan(buffer, idx * 50ms, NUM_PARTS), std::vector<int>({ NUM_PARTS }));
+  }
+  EXPECT_TRUE(push_scan(buffer, 1050ms, NUM_PARTS - 1).empty());
+
+  // no pop for more than the reset threshold, i.e., the scan expires long before it is released
+  for (Duration meas_stamp{1100ms}; meas_stamp <= 2500ms; meas_stamp += 50ms)
+  {
+    EXPECT_EQ(buffer.push(SENSOR_A, Time(meas_stamp + 10ms), Time(meas_stamp), 1), PushReturn::OK);
+  }
+  const auto result = buffer.pop(Time(2510ms));
+  // the expired scan is released in sequence instead of resetting the buffer
+  ASSERT_FALSE(result.data.empty());
+  EXPECT_EQ(result.data.front().id, SENSOR_R);
+  EXPECT_EQ(result.data.front().meas_time, Time(1050ms));
+}
+
+}  // namespace minimal_latency_buffer::test
@@ -0,0 +1,137 @@
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "minimal_latency_buffer/shared_ingest_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class SharedIngestBufferViews : public ::testing::Test
+{
+protected:
+  using IngestBuffer = minimal_latency_buffer::SharedIngestBuffer<int>;
+
+  void SetUp() override
+  {
+    IngestBuffer::ViewParams fast_view;
+    fast_view.sources = { SENSOR_A };
+    fast_view.params.max_total_wait_time = 100ms;
+
+    IngestBuffer::ViewParams fused_view;
+    fused_view.sources = { SENSOR_A, SENSOR_B };
+    fused_view.params.max_total_wait_time = 100ms;
+
+    params.views = { fast_view, fused_view };
+  }
+
+  IngestBuffer::Params params;
+
+  // period: 50ms, latency: 10ms
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 40ms, measured 10ms before sensor A
+  static constexpr auto SENSOR_B = 100U;
+  static constexpr std::size_t FAST_VIEW = 0;
+  static constexpr std::size_t FUSED_VIEW = 1;
+};
+
+TEST_F(SharedIngestBufferViews, independentSourceSubsets)
+{
+  IngestBuffer buffer(params);
+  ASSERT_EQ(buffer.numViews(), 2);
+
+  std::vector<const int *> fast_payloads;
+  std::vector<const int *> fused_payloads;
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    ASSERT_EQ(buffer.push(SENSOR_A, Time(meas_stamp + 10ms), Time(meas_stamp), static_cast<int>(idx)), PushReturn::OK);
+
+    // the fast view does not subscribe to sensor B, i.e., sensor A is released immediately
+    const auto fast_result = buffer.pop(FAST_VIEW, Time(meas_stamp + 10ms));
+    ASSERT_EQ(fast_result.data.size(), 1);
+    EXPECT_EQ(**fast_result.data.front().data, idx);
+    fast_payloads.push_back(fast_result.data.front().data->get());
+
+    const auto fused_early = buffer.pop(FUSED_VIEW, Time(meas_stamp + 10ms));
+    ASSERT_EQ(buffer.push(SENSOR_B, Time(meas_stamp + 30ms), Time(meas_stamp - 10ms), -static_cast<int>(idx)),
+              PushReturn::OK);
+    const auto fused_late = buffer.pop(FUSED_VIEW, Time(meas_stamp + 30ms));
+    for (const auto *result : { &fused_early, &fused_late })
+    {
+      for (const auto &element : result->data)
+      {
+        if (element.id == SENSOR_A)
+        {
+          fused_payloads.push_back(element.data->get());
+        }
+      }
+    }
+
+    if (idx > 3)
+    {
+      // the fused view waits for sensor B once its stream characteristics are known
+      EXPECT_TRUE(fused_early.data.empty());
+      EXPECT_EQ(fused_late.data.size(), 2);
+    }
+  }
+
+  // the payload is shared across the views instead of being copied
+  ASSERT_EQ(fused_payloads.size(), fast_payloads.size());
+  EXPECT_EQ(fused_payloads, fast_payloads);
+
+  // the stream characteristics are estimated once by the ingest
+  EXPECT_EQ(buffer.view(FAST_VIEW).getEstimatedLatency(SENSOR_A), 10ms);
+  EXPECT_EQ(buffer.view(FUSED_VIEW).getEstimatedLatency(SENSOR_A), 10ms);
+  EXPECT_EQ(buffer.view(FUSED_VIEW).getEstimatedPeriod(SENSOR_B), 50ms);
+  EXPECT_EQ(buffer.view(FUSED_VIEW).getEstimatedLatency(SENSOR_B), 40ms);
+
+  // a jump back in time resets the ingest and all views
+  EXPECT_EQ(buffer.push(SENSOR_A, Time(10ms), Time(0ms), 0), PushReturn::RESET);
+  EXPECT_EQ(buffer.view(FUSED_VIEW).getEstimatedLatency(SENSOR_B), 0ms);
+}
+
+TEST_F(SharedIngestBufferViews, matchViewOfSubscribedSources)
+{
+  // period: 50ms, latency: 5ms, solely delivered by the fast view
+  constexpr auto SENSOR_C = 150U;
+
+  params.views.at(FAST_VIEW).sources = { SENSOR_A, SENSOR_C };
+  params.views.at(FUSED_VIEW).params.mode = BufferMode::MATCH;
+  params.views.at(FUSED_VIEW).params.match.reference_stream = SENSOR_A;
+  IngestBuffer buffer(params);
+
+  std::size_t num_tuples{ 0 };
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    ASSERT_EQ(buffer.push(SENSOR_C, Time(meas_stamp + 5ms), Time(meas_stamp), static_cast<int>(idx)), PushReturn::OK);
+    ASSERT_EQ(buffer.push(SENSOR_A, Time(meas_stamp + 10ms), Time(meas_stamp), static_cast<int>(idx)), PushReturn::OK);
+    ASSERT_EQ(buffer.push(SENSOR_B, Time(meas_stamp + 30ms), Time(meas_stamp - 10ms), -static_cast<int>(idx)),
+              PushReturn::OK);
+    buffer.pop(FAST_VIEW, Time(meas_stamp + 30ms));
+
+    // the match view solely waits for its subscribed sources, i.e., sensor C never holds back a tuple
+    const auto result = buffer.pop(FUSED_VIEW, Time(meas_stamp + 30ms));
+    for (const auto &element : result.data)
+    {
+      EXPECT_NE(element.id, SENSOR_C);
+      num_tuples += element.id == SENSOR_A ? 1 : 0;
+    }
+  }
+  EXPECT_GE(num_tuples, 15);
+}
+
+TEST_F(SharedIngestBufferViews, delayingStagesRejected)
+{
+  // the shared estimation is not aware of the delay of the reordered samples
+  params.views.at(FUSED_VIEW).params.sources[SENSOR_B].reorder_window = 20ms;
+  EXPECT_THROW(IngestBuffer{ params }, std::invalid_argument);
+
+  params.views.at(FUSED_VIEW).params.sources.clear();
+  params.views.at(FUSED_VIEW).params.sources[SENSOR_B].assembly_timeout = 20ms;
+  EXPECT_THROW(IngestBuffer{ params }, std::invalid_argument);
+}
+
+}  // namespace minimal_latency_buffer::test
@@ -0,0 +1,363 @@
+#include <chrono>
+#include "gtest/gtest.h"
+
+#include "../utils.hpp"
+#include "minimal_latency_buffer/minimal_latency_buffer.hpp"
+
+using namespace std::chrono_literals;
+
+namespace minimal_latency_buffer::test
+{
+
+class MinimalLatencyBufferSourceParams : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // parametrization of the buffer is shared across all tests
+    params.max_total_wait_time = std::chrono::milliseconds(100);
+  }
+
+  MinimalLatencyBuffer::Params params;
+
+  // period: 50ms, latency: 10ms
+  static constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms
+  static constexpr auto SENSOR_B = 100U;
+};
+
+TEST_F(MinimalLatencyBufferSourceParams, limitedWaitTime)
+{
+  // the buffer must not wait longer than 20ms for sensor B
+  params.sources[SENSOR_B].max_total_wait_time = 20ms;
+  MinimalLatencyBuffer buffer(params);
+
+  push_expect_ok(buffer, SENSOR_B, 110ms, 50ms);
+  pop_expect_data(buffer, 110ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 160ms, 100ms);
+  pop_expect_data(buffer, 160ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 210ms, 150ms);
+  pop_expect_data(buffer, 210ms, 1);
+
+  // the placeholder of sensor B (meas time: 200ms) expires at 220ms instead of 260ms
+  push_expect_ok(buffer, SENSOR_A, 220ms, 210ms);
+  pop_expect_data(buffer, 220ms, 0);
+  pop_expect_data(buffer, 221ms, 1);
+
+  // the late sample is discarded accordingly
+  push_expect_ok(buffer, SENSOR_B, 260ms, 200ms);
+  pop_expect_data(buffer, 260ms, 0, 1);
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, runtimeAdjustment)
+{
+  MinimalLatencyBuffer buffer(params);
+
+  push_expect_ok(buffer, SENSOR_B, 110ms, 50ms);
+  pop_expect_data(buffer, 110ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 160ms, 100ms);
+  pop_expect_data(buffer, 160ms, 1);
+  push_expect_ok(buffer, SENSOR_B, 210ms, 150ms);
+  pop_expect_data(buffer, 210ms, 1);
+
+  // without overrides the buffer waits for sensor B
+  push_expect_ok(buffer, SENSOR_A, 220ms, 210ms);
+  pop_expect_data(buffer, 220ms, 0);
+  pop_expect_data(buffer, 250ms, 0);
+
+  // the override is applied to the next placeholder without resetting the buffer
+  buffer.setSourceParams(SENSOR_B, SourceParams{ .max_total_wait_time = 20ms });
+  EXPECT_EQ(buffer.getSourceParams(SENSOR_B).max_total_wait_time, 20ms);
+  EXPECT_FALSE(buffer.getSourceParams(SENSOR_A).max_total_wait_time.has_value());
+
+  push_expect_ok(buffer, SENSOR_B, 260ms, 200ms);
+  pop_expect_data(buffer, 260ms, 2);
+
+  // placeholder of sensor B (meas time: 250ms) expires at 270ms
+  push_expect_ok(buffer, SENSOR_A, 270ms, 260ms);
+  pop_expect_data(buffer, 270ms, 0);
+  pop_expect_data(buffer, 271ms, 1);
+
+  buffer.clearSourceParams(SENSOR_B);
+  EXPECT_FALSE(buffer.getSourceParams(SENSOR_B).max_total_wait_time.has_value());
+
+  push_expect_ok(buffer, SENSOR_B, 310ms, 250ms);
+  pop_expect_data(buffer, 310ms, 0, 1);
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, decimationKeepsEstimation)
+{
+  // period: 10ms, latency: 2ms
+  constexpr auto SENSOR_C = 150U;
+
+  params.sources[SENSOR_C].decimation = { .policy = DecimationPolicy::EVERY_NTH, .factor = 5 };
+  MinimalLatencyBuffer buffer(params);
+
+  std::size_t num_output{0};
+  for (std::size_t idx{1}; idx <= 50; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms;
+    push_expect_ok(buffer, SENSOR_C, meas_stamp + 2ms, meas_stamp);
+    num_output += buffer.pop(Time(meas_stamp + 2ms)).data.size();
+  }
+  EXPECT_EQ(num_output, 10);
+  // the estimation is based on all received samples
+  EXPECT_EQ(buffer.getEstimatedPeriod(SENSOR_C), 10ms);
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, decimationLatestPerInterval)
+{
+  // period: 10ms, latency: 2ms
+  constexpr auto SENSOR_C = 150U;
+
+  params.sources[SENSOR_C].decimation = { .policy = DecimationPolicy::LATEST_PER_INTERVAL, .interval = 50ms };
+  MinimalLatencyBuffer buffer(params);
+
+  for (std::size_t idx{1}; idx <= 50; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms;
+    push_expect_ok(buffer, SENSOR_C, meas_stamp + 2ms, meas_stamp);
+    buffer.pop(Time(meas_stamp + 2ms));
+  }
+
+  for (std::size_t idx{51}; idx <= 60; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms;
+    push_expect_ok(buffer, SENSOR_C, meas_stamp + 2ms, meas_stamp);
+    const auto result = buffer.pop(Time(meas_stamp + 2ms));
+    EXPECT_EQ(result.data.size(), idx % 5 == 4 ? 1 : 0);
+  }
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, decimationAggregation)
+{
+  // period: 10ms, latency: 2ms
+  constexpr auto SENSOR_C = 150U;
+
+  using CountBuffer = minimal_latency_buffer::MinimalLatencyBuffer<int>;
+  CountBuffer::Params count_params;
+  count_params.sources[SENSOR_C].decimation = { .policy = DecimationPolicy::EVERY_NTH, .factor = 5 };
+  CountBuffer buffer(count_params);
+  buffer.setAggregator(SENSOR_C, [](int &aggregate, int &&sample) { aggregate += sample; });
+
+  std::vector<int> output;
+  for (std::size_t idx{1}; idx <= 16; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms;
+    EXPECT_EQ(buffer.push(SENSOR_C, Time(meas_stamp + 2ms), Time(meas_stamp), 1), PushReturn::OK);
+    for (const auto &element : buffer.pop(Time(meas_stamp + 2ms)).data)
+    {
+      output.push_back(*element.data);
+    }
+  }
+  // the dropped samples are merged into the next stored sample
+  EXPECT_EQ(output, std::vector<int>({ 1, 5, 5, 5 }));
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, reorderWindow)
+{
+  // period: 10ms, latency: 2ms (every fifth sample is received after its successor)
+  constexpr auto SENSOR_C = 150U;
+
+  const auto run = [&](const MinimalLatencyBuffer::Params &run_params) {
+    MinimalLatencyBuffer buffer(run_params);
+    std::vector<Time> output;
+    std::size_t num_discarded{0};
+    const auto push_pop = [&](Duration receipt_stamp, Duration meas_stamp) {
+      push_expect_ok(buffer, SENSOR_C, receipt_stamp, meas_stamp);
+      auto result = buffer.pop(Time(receipt_stamp));
+      for (const auto &element : result.data)
+      {
+        output.push_back(element.meas_time);
+      }
+      num_discarded += result.discarded_data.size();
+    };
+    for (std::size_t idx{1}; idx <= 50; ++idx)
+    {
+      const Duration meas_stamp = idx * 10ms;
+      if (idx % 5 == 0)
+      {
+        continue;
+      }
+      push_pop(meas_stamp + 2ms, meas_stamp);
+      if (idx % 5 == 1 and idx > 1)
+      {
+        push_pop(meas_stamp + 3ms, meas_stamp - 10ms);
+      }
+    }
+    EXPECT_TRUE(std::is_sorted(output.begin(), output.end()));
+    return num_discarded;
+  };
+
+  EXPECT_GT(run(params), 0);
+
+  // the reorder stage recovers the swapped samples
+  params.sources[SENSOR_C].reorder_window = 5ms;
+  EXPECT_EQ(run(params), 0);
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, bestEffortSource)
+{
+  // sensor B is merged into the output if in time, but never holds back sensor A
+  params.sources[SENSOR_B].best_effort = true;
+  params.sources[SENSOR_B].late_routing = LateRouting::LATE;
+  MinimalLatencyBuffer buffer(params);
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    pop_expect_data(buffer, meas_stamp + 10ms, 1);
+    EXPECT_EQ(buffer.getEarliestHoldBackReceptionTime(), Time::max());
+
+    if (idx % 4 == 0)
+    {
+      // received prior to the next sample of sensor A
+      push_expect_ok(buffer, SENSOR_B, meas_stamp + 25ms, meas_stamp + 20ms);
+      pop_expect_data(buffer, meas_stamp + 25ms, 1);
+    }
+    else
+    {
+      // received after the release of a later sample of sensor A
+      push_expect_ok(buffer, SENSOR_B, meas_stamp + 30ms, meas_stamp - 30ms);
+      const auto result = pop_expect_data(buffer, meas_stamp + 30ms, 0, 0);
+      ASSERT_EQ(result.late_data.size(), 1);
+      EXPECT_EQ(result.late_data.front().id, SENSOR_B);
+    }
+  }
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, staleSamples)
+{
+  // sensor B is only useful up to 50ms after its measurement, i.e., its samples released after waiting for the slow
+  // sensor C are dropped
+  // period: 50ms, latency: 61ms
+  constexpr auto SENSOR_C = 150U;
+  params.sources[SENSOR_B].max_age_at_release = 50ms;
+  params.sources[SENSOR_B].report_stale = true;
+  MinimalLatencyBuffer buffer(params);
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    // sensor B is received 20ms after its measurement
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 20ms, meas_stamp);
+    const auto early = buffer.pop(Time(meas_stamp + 20ms));
+    push_expect_ok(buffer, SENSOR_C, meas_stamp + 60ms, meas_stamp - 1ms);
+    const auto late = buffer.pop(Time(meas_stamp + 60ms));
+
+    if (idx > 3)
+    {
+      EXPECT_TRUE(early.data.empty());
+      ASSERT_EQ(late.data.size(), 1);
+      EXPECT_EQ(late.data.front().id, SENSOR_C);
+      ASSERT_EQ(late.stale_data.size(), 1);
+      EXPECT_EQ(late.stale_data.front().id, SENSOR_B);
+    }
+  }
+  EXPECT_GE(buffer.getNumberOfStaleSamples(SENSOR_B), 17);
+  EXPECT_EQ(buffer.getNumberOfStaleSamples(SENSOR_C), 0);
+
+  // the dropped samples are solely counted without reporting them
+  params.sources[SENSOR_B].report_stale = false;
+  buffer.setSourceParams(SENSOR_B, params.sources[SENSOR_B]);
+  const std::size_t num_stale = buffer.getNumberOfStaleSamples(SENSOR_B);
+  push_expect_ok(buffer, SENSOR_B, 1070ms, 1050ms);
+  push_expect_ok(buffer, SENSOR_C, 1110ms, 1049ms);
+  const auto result = pop_expect_data(buffer, 1110ms, 1);
+  EXPECT_TRUE(result.stale_data.empty());
+  EXPECT_EQ(buffer.getNumberOfStaleSamples(SENSOR_B), num_stale + 1);
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, chunkedLane)
+{
+  // period: 10ms, latency: 2ms
+  constexpr auto SENSOR_C = 150U;
+
+  using CountBuffer = minimal_latency_buffer::MinimalLatencyBuffer<int>;
+  CountBuffer::Params count_params;
+  count_params.max_total_wait_time = 100ms;
+  count_params.sources[SENSOR_C].chunked = true;
+  CountBuffer buffer(count_params);
+
+  const auto push = [&](std::size_t id, Duration receipt_time, Duration meas_time) {
+    EXPECT_EQ(buffer.push(id, Time(receipt_time), Time(meas_time), 1), PushReturn::OK);
+  };
+  std::size_t num_chunk_samples{0};
+  const auto pop = [&](Duration time) {
+    for (const auto &chunk : buffer.pop(Time(time)).chunks)
+    {
+      num_chunk_samples += chunk.size();
+    }
+  };
+
+  // interleaved reception of both sensors (the first samples of sensor A are discarded while it is initialized)
+  for (std::size_t idx{0}; idx < 39; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms + 5ms;
+    push(SENSOR_C, meas_stamp + 2ms, meas_stamp);
+    pop(meas_stamp + 2ms);
+    if (idx % 5 == 0)
+    {
+      push(SENSOR_A, meas_stamp + 5ms, meas_stamp - 5ms);
+      pop(meas_stamp + 5ms);
+    }
+    // the lane is solely represented by its next placeholder
+    EXPECT_LE(buffer.total_size(), 3);
+  }
+  EXPECT_EQ(num_chunk_samples, 39);
+
+  // the lane samples received while the output was stalled are split at the sample of sensor A
+  for (std::size_t idx{39}; idx < 45; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms + 5ms;
+    push(SENSOR_C, meas_stamp + 2ms, meas_stamp);
+    if (idx == 40)
+    {
+      push(SENSOR_A, 410ms, 400ms);
+    }
+  }
+  EXPECT_EQ(buffer.getNumberOfQueuedElements(), 7);
+
+  const auto result = buffer.pop(Time(447ms));
+  ASSERT_EQ(result.data.size(), 1);
+  EXPECT_EQ(result.data.front().meas_time, Time(400ms));
+  ASSERT_EQ(result.chunks.size(), 2);
+  EXPECT_EQ(result.chunks.front().position, 0);
+  EXPECT_EQ(result.chunks.front().meas_times, std::vector<Time>({ Time(395ms) }));
+  EXPECT_EQ(result.chunks.back().position, 1);
+  EXPECT_EQ(result.chunks.back().meas_times,
+            std::vector<Time>({ Time(405ms), Time(415ms), Time(425ms), Time(435ms), Time(445ms) }));
+  EXPECT_EQ(result.buffer_time, Time(445ms));
+
+  // the placeholders created while both sensors stalled are dropped once they resume
+  pop(600ms);
+  for (std::size_t idx{60}; idx < 70; ++idx)
+  {
+    const Duration meas_stamp = idx * 10ms + 5ms;
+    push(SENSOR_C, meas_stamp + 2ms, meas_stamp);
+    pop(meas_stamp + 2ms);
+    if (idx % 5 == 0)
+    {
+      push(SENSOR_A, meas_stamp + 5ms, meas_stamp - 5ms);
+      pop(meas_stamp + 5ms);
+    }
+  }
+  EXPECT_LE(buffer.total_size(), 3);
+}
+
+TEST_F(MinimalLatencyBufferSourceParams, chunkedLaneRequiresSingleMode)
+{
+  params.mode = BufferMode::BATCH;
+  params.sources[SENSOR_A].chunked = true;
+  EXPECT_THROW(MinimalLatencyBuffer{ params }, std::invalid_argument);
+
+  params.sources.clear();
+  MinimalLatencyBuffer buffer(params);
+  EXPECT_THROW(buffer.setSourceParams(SENSOR_A, SourceParams{ .chunked = true, .best_effort = true }),
+               std::invalid_argument);
+  // the rejected overrides are not applied partially
+  EXPECT_FALSE(buffer.getSourceParams(SENSOR_A).best_effort);
+}
+
+}  // namespace minimal_latency_buffer::test
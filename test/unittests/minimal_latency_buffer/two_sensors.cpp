@@ -264,6 +264,132 @@ TEST_F(MinimalLatencyBufferTwoSources, missingMeasurements)
   pop_expect_data(buffer, 410ms, 2);
 }
 
+TEST_F(MinimalLatencyBufferTwoSources, missingSampleEvents)
+{
+  params.report_missing_samples = true;
+  MinimalLatencyBuffer buffer(params);
+
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 20ms, measurement time offset: 5ms
+  constexpr auto SENSOR_B = 100U;
+
+  for (std::size_t idx{1}; idx <= 10; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    EXPECT_TRUE(buffer.pop(Time(meas_stamp + 10ms)).missing_samples.empty());
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 25ms, meas_stamp + 5ms);
+    EXPECT_TRUE(buffer.pop(Time(meas_stamp + 25ms)).missing_samples.empty());
+  }
+
+  // the sample of sensor B measured at 555ms is not received
+  push_expect_ok(buffer, SENSOR_A, 560ms, 550ms);
+  EXPECT_TRUE(pop_expect_data(buffer, 575ms, 1).missing_samples.empty());
+  const auto result = pop_expect_data(buffer, 576ms, 0);
+  ASSERT_EQ(result.missing_samples.size(), 1);
+  EXPECT_EQ(result.missing_samples.front().id, SENSOR_B);
+  EXPECT_EQ(result.missing_samples.front().earliest_meas_time, Time(555ms));
+  EXPECT_EQ(result.missing_samples.front().latest_receipt_time, Time(575ms));
+
+  // the expired placeholder is solely reported once
+  EXPECT_TRUE(pop_expect_data(buffer, 577ms, 0).missing_samples.empty());
+  push_expect_ok(buffer, SENSOR_A, 610ms, 600ms);
+  EXPECT_TRUE(pop_expect_data(buffer, 610ms, 1).missing_samples.empty());
+}
+
+TEST_F(MinimalLatencyBufferTwoSources, watermark)
+{
+  MinimalLatencyBuffer buffer(params);
+
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms, measurement time offset: 25ms
+  constexpr auto SENSOR_B = 100U;
+
+  Time watermark{};
+  std::size_t num_ahead_of_output{0};
+  for (Duration time{1ms}; time <= 1000ms; time += 1ms)
+  {
+    if (time % 50ms == 10ms)
+    {
+      push_expect_ok(buffer, SENSOR_A, time, time - 10ms);
+    }
+    if (time % 50ms == 35ms and time > 50ms)
+    {
+      push_expect_ok(buffer, SENSOR_B, time, time - 60ms);
+    }
+
+    const auto result = buffer.pop(Time(time));
+    EXPECT_GE(result.watermark, watermark);
+    EXPECT_EQ(buffer.getWatermark(), result.watermark);
+    // no older sample is released afterwards (as soon as the estimation of both sensors is initialized)
+    for (const auto &element : result.data)
+    {
+      if (time > 300ms)
+      {
+        EXPECT_GE(element.meas_time, watermark);
+      }
+    }
+    // the watermark exceeds the latest output, i.e., downstream windows can be closed prior to the next output
+    if (result.watermark > result.buffer_time)
+    {
+      ++num_ahead_of_output;
+    }
+    watermark = result.watermark;
+  }
+  EXPECT_GT(num_ahead_of_output, 0);
+}
+
+TEST_F(MinimalLatencyBufferTwoSources, discardPolicy)
+{
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms (never waited for, i.e., every sample is discarded)
+  constexpr auto SENSOR_B = 100U;
+  params.sources[SENSOR_B].best_effort = true;
+
+  for (const DiscardPolicy policy :
+       { DiscardPolicy::COLLECT, DiscardPolicy::COUNT, DiscardPolicy::CALLBACK, DiscardPolicy::DROP })
+  {
+    params.discard_policy = policy;
+    MinimalLatencyBuffer buffer(params);
+    std::size_t num_callbacks{0};
+    buffer.setDiscardCallback([&num_callbacks, SENSOR_B](MinimalLatencyBuffer::TimeData_t &&element) {
+      EXPECT_EQ(element.id, SENSOR_B);
+      ++num_callbacks;
+    });
+
+    std::size_t num_collected{0};
+    for (std::size_t idx{1}; idx <= 10; ++idx)
+    {
+      const Duration meas_stamp = idx * 50ms;
+      push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+      pop_expect_data(buffer, meas_stamp + 10ms, 1);
+      push_expect_ok(buffer, SENSOR_B, meas_stamp + 30ms, meas_stamp - 30ms);
+      num_collected += buffer.pop(Time(meas_stamp + 30ms)).discarded_data.size();
+    }
+
+    EXPECT_EQ(num_collected, policy == DiscardPolicy::COLLECT ? 10 : 0);
+    EXPECT_EQ(buffer.getNumberOfDiscardedSamples(SENSOR_B), policy == DiscardPolicy::COUNT ? 10 : 0);
+    EXPECT_EQ(num_callbacks, policy == DiscardPolicy::CALLBACK ? 10 : 0);
+  }
+
+  // without any callback, the discarded samples are reported instead of being dropped
+  params.discard_policy = DiscardPolicy::CALLBACK;
+  MinimalLatencyBuffer buffer(params);
+  std::size_t num_collected{0};
+  for (std::size_t idx{1}; idx <= 10; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    pop_expect_data(buffer, meas_stamp + 10ms, 1);
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 30ms, meas_stamp - 30ms);
+    num_collected += buffer.pop(Time(meas_stamp + 30ms)).discarded_data.size();
+  }
+  EXPECT_EQ(num_collected, 10);
+}
+
 TEST_F(MinimalLatencyBufferTwoSources, synchronizedSensorsWithBatching)
 {
   using namespace minimal_latency_buffer;
@@ -319,8 +445,163 @@ TEST_F(MinimalLatencyBufferTwoSources, synchronizedSensorsWithBatching)
   pop_expect_data(buffer, 375ms, 2);
 }
 
+TEST_F(MinimalLatencyBufferTwoSources, batchingReleasesClosedWindows)
+{
+  using namespace minimal_latency_buffer;
+  using namespace std::chrono_literals;
+
+  params.mode = BufferMode::BATCH;
+  MinimalLatencyBuffer buffer(params);
+
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 20ms, measurement time offset: 5ms
+  constexpr auto SENSOR_B = 100U;
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    buffer.pop(Time(meas_stamp + 10ms));
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 25ms, meas_stamp + 5ms);
+    buffer.pop(Time(meas_stamp + 25ms));
+  }
+
+  // stall: several cycles are received without any pop in between
+  for (std::size_t idx{21}; idx <= 25; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    if (idx < 25)
+    {
+      push_expect_ok(buffer, SENSOR_B, meas_stamp + 25ms, meas_stamp + 5ms);
+    }
+  }
+
+  // all closed windows are released, the last one still waits for sensor B
+  auto result = pop_expect_data(buffer, 1260ms, 8);
+  EXPECT_EQ(result.batch_starts, std::vector<std::size_t>({ 0, 2, 4, 6 }));
+  EXPECT_EQ(result.data.back().meas_time, Time(1205ms));
+
+  push_expect_ok(buffer, SENSOR_B, 1275ms, 1255ms);
+  result = pop_expect_data(buffer, 1275ms, 2);
+  EXPECT_EQ(result.batch_starts, std::vector<std::size_t>({ 0 }));
+}
+
+TEST_F(MinimalLatencyBufferTwoSources, gridAlignedBatches)
+{
+  using namespace minimal_latency_buffer;
+  using namespace std::chrono_literals;
+
+  params.mode = BufferMode::GRID;
+  params.grid.period = 50ms;
+  // the end of a cycle is passed once the earliest expected measurement time of the next sample is after it
+  params.max_abs_measurement_jitter = 5ms;
+  MinimalLatencyBuffer buffer(params);
+
+  // period: 50ms, latency: 10ms, measurement time offset: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 15ms, measurement time offset: 30ms
+  constexpr auto SENSOR_B = 100U;
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration cycle_start = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, cycle_start + 20ms, cycle_start + 10ms);
+    buffer.pop(Time(cycle_start + 20ms));
+    push_expect_ok(buffer, SENSOR_B, cycle_start + 45ms, cycle_start + 30ms);
+    buffer.pop(Time(cycle_start + 45ms));
+  }
+
+  // the cycle is not complete before the sample of sensor B is received
+  push_expect_ok(buffer, SENSOR_A, 1070ms, 1060ms);
+  pop_expect_data(buffer, 1070ms, 0);
+  push_expect_ok(buffer, SENSOR_B, 1095ms, 1080ms);
+  auto result = pop_expect_data(buffer, 1095ms, 2);
+  EXPECT_EQ(result.batch_starts, std::vector<std::size_t>({ 0 }));
+
+  // missing sample of sensor B: the cycle is released once its placeholder expired
+  push_expect_ok(buffer, SENSOR_A, 1120ms, 1110ms);
+  pop_expect_data(buffer, 1120ms, 0);
+  pop_expect_data(buffer, 1150ms, 1);
+}
+
 // intended for simulation / dataset scenarios where only a single timestamp per data sample is available
 // and thus the latency as seen by the buffer is zero
+TEST_F(MinimalLatencyBufferTwoSources, speculativeRelease)
+{
+  params.speculative = { .enabled = true, .max_retraction = 100ms };
+  MinimalLatencyBuffer buffer(params);
+
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms, measurement time offset: 5ms
+  constexpr auto SENSOR_B = 100U;
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    // sensor A is released without waiting for sensor B
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    auto result = pop_expect_data(buffer, meas_stamp + 10ms, 1);
+    EXPECT_TRUE(result.corrections.empty());
+
+    // the sample of sensor B belongs in front of the previously released sample of sensor A
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 20ms, meas_stamp - 45ms);
+    result = pop_expect_data(buffer, meas_stamp + 20ms, 0);
+    ASSERT_EQ(result.corrections.size(), 1);
+    EXPECT_EQ(result.corrections.front().sample.meas_time, Time(meas_stamp - 45ms));
+    EXPECT_EQ(result.corrections.front().num_retracted, 1);
+  }
+
+  // samples exceeding the retraction window are discarded
+  push_expect_ok(buffer, SENSOR_B, 1025ms, 895ms);
+  const auto result = pop_expect_data(buffer, 1025ms, 0, 1);
+  EXPECT_TRUE(result.corrections.empty());
+}
+
+TEST_F(MinimalLatencyBufferTwoSources, speculativeMissingSamples)
+{
+  params.speculative = { .enabled = true, .max_retraction = 100ms };
+  params.report_missing_samples = true;
+  MinimalLatencyBuffer buffer(params);
+
+  // period: 50ms, latency: 10ms
+  constexpr auto SENSOR_A = 50U;
+  // period: 50ms, latency: 60ms, measurement time offset: 5ms
+  constexpr auto SENSOR_B = 100U;
+
+  for (std::size_t idx{1}; idx <= 20; ++idx)
+  {
+    const Duration meas_stamp = idx * 50ms;
+    push_expect_ok(buffer, SENSOR_A, meas_stamp + 10ms, meas_stamp);
+    // the sample of sensor B is passed by the speculative release, but it is still expected within its deadline
+    EXPECT_TRUE(pop_expect_data(buffer, meas_stamp + 10ms, 1).missing_samples.empty());
+    push_expect_ok(buffer, SENSOR_B, meas_stamp + 20ms, meas_stamp - 45ms);
+    const auto result = pop_expect_data(buffer, meas_stamp + 20ms, 0);
+    EXPECT_EQ(result.corrections.size(), 1);
+    EXPECT_TRUE(result.missing_samples.empty());
+  }
+
+  // the sample of sensor B measured at 1005ms is not received, it is reported once its deadline has expired
+  std::vector<MinimalLatencyBuffer::MissingSample_t> missing_samples;
+  for (Duration time{1021ms}; time <= 1100ms; time += 1ms)
+  {
+    if (time == 1060ms)
+    {
+      push_expect_ok(buffer, SENSOR_A, time, 1050ms);
+    }
+    const auto result = buffer.pop(Time(time));
+    for (const auto &missing : result.missing_samples)
+    {
+      EXPECT_GT(Time(time), missing.latest_receipt_time);
+      missing_samples.push_back(missing);
+    }
+  }
+  ASSERT_EQ(missing_samples.size(), 1);
+  EXPECT_EQ(missing_samples.front().id, SENSOR_B);
+}
+
 TEST_F(MinimalLatencyBufferTwoSources, zeroLatency)
 {
   using namespace minimal_latency_buffer;